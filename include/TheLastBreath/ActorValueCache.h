@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    enum class CachedValue : std::uint8_t {
+        Stamina,
+        PermanentStamina,   // Max stamina without damage modifiers
+        Block,
+        SpeedMult,
+        AttackDamageMult,
+
+        kCount
+    };
+
+    // Per-actor actor value snapshot shared by the handlers. A value is read through
+    // ActorValueOwner at most once per update pass and served from the snapshot after
+    // that; our own writes mark the actor dirty so the next read sees them.
+    // Snapshots live in a fixed direct-mapped table: colliding actors evict each other
+    // and simply read again, so a lookup never allocates and nothing needs pruning.
+    class ActorValueCache {
+    public:
+        static ActorValueCache* GetSingleton() {
+            static ActorValueCache singleton;
+            return &singleton;
+        }
+
+        // Start of an update pass - everything captured before is stale
+        void BeginPass();
+
+        float Get(RE::Actor* actor, CachedValue value);
+
+        void MarkDirty(RE::FormID formID);
+        void ClearAll();
+
+    private:
+        ActorValueCache() = default;
+        ActorValueCache(const ActorValueCache&) = delete;
+        ActorValueCache(ActorValueCache&&) = delete;
+
+        static constexpr std::size_t kSlotBits = 8;
+
+        static constexpr std::size_t SlotOf(RE::FormID formID) {
+            return static_cast<std::size_t>((formID * 0x9E3779B1u) >> (32 - kSlotBits));
+        }
+
+        struct Snapshot {
+            RE::FormID formID = 0;       // 0 = empty slot
+            std::uint32_t pass = 0;
+            std::uint8_t validMask = 0;  // Bit per CachedValue captured in this pass
+            std::array<float, static_cast<std::size_t>(CachedValue::kCount)> values{};
+        };
+
+        std::mutex mutex;
+        std::uint32_t currentPass = 1;
+        std::array<Snapshot, std::size_t{ 1 } << kSlotBits> snapshots{};
+    };
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace TheLastBreath {
+
+    // Memoized engine power attack costs for when the closed-form model is unavailable.
+    // Entries are keyed by (weapon, attack data) per actor and stamped with a perk epoch,
+    // so repeated light attacks with the same weapon cost one probe instead of a nested
+    // engine evaluation. Equip changes and active effects applied to or removed from an
+    // actor drop that actor's entries; closing the skills or level up menu (where perks and
+    // stamina change) bumps the epoch for everyone. Perks added by scripts or the console
+    // and perk entries conditioned on actor values change without an event, so entries also
+    // expire after kEntryLifetime - a combo string still hits, a stale cost can't outlive it.
+    class AttackCostCache :
+        public RE::BSTEventSink<RE::MenuOpenCloseEvent>,
+        public RE::BSTEventSink<RE::TESActiveEffectApplyRemoveEvent> {
+    public:
+        static AttackCostCache* GetSingleton() {
+            static AttackCostCache singleton;
+            return &singleton;
+        }
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::MenuOpenCloseEvent* a_event,
+            RE::BSTEventSource<RE::MenuOpenCloseEvent>* a_eventSource) override;
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::TESActiveEffectApplyRemoveEvent* a_event,
+            RE::BSTEventSource<RE::TESActiveEffectApplyRemoveEvent>* a_eventSource) override;
+
+        std::optional<float> Find(RE::Actor* actor, const RE::BGSAttackData* attackData);
+        void Store(RE::Actor* actor, const RE::BGSAttackData* attackData, float cost);
+
+        void InvalidateActor(RE::FormID formID);
+        void ClearAll();
+
+    private:
+        AttackCostCache() = default;
+        AttackCostCache(const AttackCostCache&) = delete;
+        AttackCostCache(AttackCostCache&&) = delete;
+
+        static constexpr std::size_t kEntriesPerActor = 4;  // A combo string uses a handful of attack datas
+        static constexpr auto kEntryLifetime = std::chrono::seconds(1);
+
+        struct Entry {
+            RE::FormID weapon = 0;
+            const RE::BGSAttackData* attackData = nullptr;  // nullptr = empty
+            std::uint32_t epoch = 0;
+            float cost = 0.0f;
+            std::chrono::steady_clock::time_point expiresAt;
+        };
+
+        struct ActorEntries {
+            std::array<Entry, kEntriesPerActor> entries{};
+            std::size_t next = 0;
+        };
+
+        static RE::FormID GetAttackWeapon(RE::Actor* actor, const RE::BGSAttackData* attackData);
+
+        std::atomic<std::uint32_t> perkEpoch = 1;
+
+        std::mutex mutex;
+        std::unordered_map<RE::FormID, ActorEntries> actors;
+    };
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+
+// Power attack stamina formula the closed-form attack cost model evaluates, free of game
+// types so tests can check it against engine results recorded in game (bRecordAttackCosts).
+namespace TheLastBreath::AttackCostFormula {
+
+    // Engine results are floats built from the same inputs - anything beyond rounding is a real difference
+    inline constexpr float kTolerance = 0.01f;
+
+    struct Inputs {
+        float weaponBase = 0.0f;     // fStaminaAttackWeaponBase
+        float weaponMult = 0.0f;     // fStaminaAttackWeaponMult
+        float powerPenalty = 0.0f;   // fPowerAttackStaminaPenalty
+        float weight = 0.0f;         // Weapon in the attacking hand, 0 unarmed
+        float staminaMult = 0.0f;    // BGSAttackData stamina mult
+    };
+
+    // Cost before the ModPowerAttackStamina perk entry point
+    constexpr float PowerAttackCost(const Inputs& in) {
+        return (in.weaponBase + in.weight * in.weaponMult) * in.powerPenalty * in.staminaMult;
+    }
+
+    inline bool Matches(float modelCost, float engineCost) {
+        return std::abs(modelCost - engineCost) <= kTolerance * std::max(1.0f, engineCost);
+    }
+
+}
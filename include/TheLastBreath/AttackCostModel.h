@@ -0,0 +1,65 @@
+#pragma once
+#include "TheLastBreath/AttackCostFormula.h"
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <optional>
+
+namespace TheLastBreath {
+
+    // Closed-form power attack stamina cost, used as the baseline for light attacks:
+    //   (fStaminaAttackWeaponBase + weight * fStaminaAttackWeaponMult)
+    //     * fPowerAttackStaminaPenalty * attack data stamina mult, then the ModPowerAttackStamina perk entry point.
+    // Reads the same inputs the engine does, without calling it or touching the shared BGSAttackData.
+    //
+    // Every real power attack is also costed by the engine, so those results are compared against
+    // the model. Callers ask the engine until the first power attack agrees with the model, and if
+    // they ever disagree (another plugin changing the formula) the model disables itself for good.
+    // Bashes are costed differently by the engine and are never compared.
+    class AttackCostModel {
+    public:
+        static AttackCostModel* GetSingleton() {
+            static AttackCostModel singleton;
+            return &singleton;
+        }
+
+        // Resolve the game settings (call at kDataLoaded)
+        void Initialize();
+
+        // nullopt when the model is unavailable, not yet validated, or has been disabled by a mismatch
+        std::optional<float> PowerAttackCost(RE::Actor* actor, const RE::BGSAttackData* attackData);
+
+        // Compare the model against a power attack cost the engine just computed for the same attack data
+        void Validate(RE::Actor* actor, const RE::BGSAttackData* attackData, float engineCost);
+
+        bool IsAvailable() const { return available.load(std::memory_order_relaxed); }
+        bool IsValidated() const { return validated.load(std::memory_order_relaxed); }
+
+    private:
+        AttackCostModel() = default;
+        AttackCostModel(const AttackCostModel&) = delete;
+        AttackCostModel(AttackCostModel&&) = delete;
+
+        struct Costing {
+            AttackCostFormula::Inputs inputs;
+            float cost = 0.0f;   // After the perk entry point
+        };
+
+        Costing Compute(RE::Actor* actor, const RE::BGSAttackData* attackData) const;
+
+        // [Debug] bRecordAttackCosts - one CSV row per validated power attack, the test fixture format
+        void RecordRow(const Costing& costing, float engineCost);
+
+        // Read every call - other plugins may change game settings after load
+        RE::Setting* weaponBase = nullptr;
+        RE::Setting* weaponMult = nullptr;
+        RE::Setting* powerPenalty = nullptr;
+
+        std::atomic<bool> available = false;
+        std::atomic<bool> validated = false;
+
+        std::ofstream costFile;
+        std::mutex costFileMutex;
+    };
+
+}
@@ -1,5 +1,5 @@
 #pragma once
-#include <unordered_map>
+#include "TheLastBreath/ParryChainTable.h"
 #include <chrono>
 #include <mutex>
 
@@ -21,20 +21,20 @@ namespace TheLastBreath {
         // Call this on successful timed block
         void OnSuccessfulTimedBlock(RE::Actor* blocker, RE::Actor* aggressor);
 
-        // Call this when timed block fails or regular block happens
-        void OnTimedBlockFailed(RE::Actor* blocker);
+        // Call this when a timed block deflects a projectile - sparks and sound only, the parry chain is untouched
+        void OnProjectileDeflected(RE::Actor* blocker);
+
+        // Call this when timed block fails or regular block happens - ends the chain against that aggressor
+        void OnTimedBlockFailed(RE::Actor* blocker, RE::Actor* aggressor);
 
         // Clear tracking for an actor
         void ClearActor(RE::Actor* actor);
 
-        // Update function for timeout checking
-        void Update();
-
-        // Get current parry level for an actor (0-4, where 0 = next is parry 1)
-        uint32_t GetCurrentParryCount(RE::Actor* actor) const;
+        // Current parry count against the last parried aggressor (0 = next is parry 1)
+        uint32_t GetCurrentParryCount(RE::Actor* actor);
 
-        // Play slow time effect for timed blocks
-        void PlaySlowTimeEffect(uint32_t parryLevel);
+        // Play slow time effect for timed blocks (durationScale < 1 when the frame governor shortens it)
+        void PlaySlowTimeEffect(uint32_t parryLevel, float durationScale = 1.0f);
 
         // Trigger Elden Counter if available
         void TriggerEldenCounter(RE::Actor* blocker, uint32_t parryLevel);
@@ -44,24 +44,13 @@ namespace TheLastBreath {
         BlockEffectsHandler(const BlockEffectsHandler&) = delete;
         BlockEffectsHandler(BlockEffectsHandler&&) = delete;
 
-        struct TimedBlockState {
-            uint32_t consecutiveCount = 0;  // 0-4 for parries 1-5
-            std::chrono::steady_clock::time_point lastParryTime;
-            bool isPerfectParryActive = false;
-
-            // Calculate current timeout based on parry count
-            float GetCurrentTimeout(float baseTimeout) const {
-                // Base + increment for each parry
-                // After parry 1: base + 1
-                // After parry 2: base + 2
-                // After parry 3: base + 3
-                // After parry 4: base + 4
-                return baseTimeout + static_cast<float>(consecutiveCount);
-            }
-        };
-
-        std::unordered_map<RE::FormID, TimedBlockState> actorStates;
-        mutable std::mutex statesMutex;  // Protects actorStates from race conditions
+        // Parries landed so far per (blocker, aggressor), below the ladder length, and the
+        // aggressor of each blocker's last parry. Expired chains are reclaimed by the table itself.
+        ParryChainTable chains;
+        mutable std::mutex statesMutex;  // Protects chains
+
+        // Aggressor part of the chain key (0 = one chain per blocker in bGlobalParryChain mode)
+        static RE::FormID ChainAggressor(RE::Actor* aggressor);
 
         // Determine what equipment the blocker is using
         BlockEquipmentType GetBlockEquipmentType(RE::Actor* blocker);
@@ -69,8 +58,8 @@ namespace TheLastBreath {
         // Get the weapon/shield node for spark positioning
         RE::NiAVObject* GetBlockEquipmentNode(RE::Actor* blocker, BlockEquipmentType equipType);
 
-        // Play the spark effect
-        void PlayBlockSpark(RE::Actor* blocker, BlockEquipmentType equipType, uint32_t parryLevel);
+        // Play the spark effect (withRing = false when the frame governor sheds the ring)
+        void PlayBlockSpark(RE::Actor* blocker, BlockEquipmentType equipType, uint32_t parryLevel, bool withRing);
 
         // Play the appropriate parry sound
         void PlayBlockSound(RE::Actor* blocker, BlockEquipmentType equipType, uint32_t parryLevel);
@@ -78,7 +67,7 @@ namespace TheLastBreath {
         // Apply heavy stagger (perfect parry / guard break) with custom magnitude
         void ApplyStagger(RE::Actor* aggressor, RE::Actor* blocker, float magnitude);
 
-        // Apply light stagger (parries 1-4) with custom magnitude
+        // Apply light stagger (parries before the final level) with custom magnitude
         void ApplyLightStagger(RE::Actor* aggressor, RE::Actor* blocker, float magnitude);
 
         // Core stagger function (copied from Valhalla/Elden Parry)
@@ -0,0 +1,141 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace TheLastBreath {
+
+    // Lifecycle of a single actor's block press
+    //   Idle     - button not held
+    //   Delay    - button held, waiting for the block animation delay
+    //   Window   - timed block window open
+    //   Consumed - window used by a timed block, further hits are regular blocks
+    //   Held     - window expired without a hit, further hits are regular blocks
+    enum class BlockPhase : std::uint8_t {
+        Idle,
+        Delay,
+        Window,
+        Consumed,
+        Held,
+
+        kCount
+    };
+
+    // How a hit on a blocking actor is treated
+    enum class BlockType {
+        None,
+        Timed,
+        Regular
+    };
+
+    enum class BlockInput : std::uint8_t {
+        Press,
+        Release,
+        DelayElapsed,
+        WindowElapsed,
+        Consume,
+
+        kCount
+    };
+
+    namespace BlockStateMachine {
+
+        inline constexpr std::size_t kPhaseCount = static_cast<std::size_t>(BlockPhase::kCount);
+        inline constexpr std::size_t kInputCount = static_cast<std::size_t>(BlockInput::kCount);
+
+        using Row = std::array<BlockPhase, kInputCount>;
+
+        // One argument per input so a row can't be left half filled
+        constexpr Row MakeRow(BlockPhase press, BlockPhase release, BlockPhase delayElapsed,
+            BlockPhase windowElapsed, BlockPhase consume) {
+            return { press, release, delayElapsed, windowElapsed, consume };
+        }
+
+        using enum BlockPhase;
+
+        //                                        Press   Release DelayElapsed WindowElapsed Consume
+        inline constexpr auto kTransitions = std::to_array<Row>({
+            /* Idle     */ MakeRow(Delay,  Idle,   Idle,        Idle,         Idle),
+            /* Delay    */ MakeRow(Delay,  Idle,   Window,      Delay,        Delay),
+            /* Window   */ MakeRow(Delay,  Idle,   Window,      Held,         Consumed),
+            /* Consumed */ MakeRow(Delay,  Idle,   Consumed,    Consumed,     Consumed),
+            /* Held     */ MakeRow(Delay,  Idle,   Held,        Held,         Held),
+        });
+
+        static_assert(kTransitions.size() == kPhaseCount, "Block transition table is missing a phase");
+
+        constexpr bool IsTableValid() {
+            for (const auto& row : kTransitions) {
+                for (auto next : row) {
+                    if (static_cast<std::size_t>(next) >= kPhaseCount) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static_assert(IsTableValid(), "Block transition table targets an invalid phase");
+
+        constexpr BlockPhase Next(BlockPhase phase, BlockInput input) {
+            return kTransitions[static_cast<std::size_t>(phase)][static_cast<std::size_t>(input)];
+        }
+
+        // Apply the time driven inputs for a press that happened `sincePress` seconds ago
+        constexpr BlockPhase Advance(BlockPhase phase, float sincePress, float delay, float window) {
+            if (sincePress >= delay) {
+                phase = Next(phase, BlockInput::DelayElapsed);
+            }
+            if (sincePress - delay > window) {
+                phase = Next(phase, BlockInput::WindowElapsed);
+            }
+            return phase;
+        }
+
+        // Block type of a hit landing in `phase` (after Advance caught the phase up to the hit).
+        // TimedBlockHandler::CheckBlockType and the session replay both classify through this.
+        constexpr BlockType Classify(BlockPhase phase) {
+            switch (phase) {
+            case Idle:   return BlockType::None;
+            case Window: return BlockType::Timed;
+            default:     return BlockType::Regular;
+            }
+        }
+
+        // Every phase returns to Idle on release and restarts on press
+        constexpr bool CheckResetInputs() {
+            for (std::size_t i = 0; i < kPhaseCount; ++i) {
+                auto phase = static_cast<BlockPhase>(i);
+                if (Next(phase, BlockInput::Release) != Idle || Next(phase, BlockInput::Press) != Delay) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Consumed and Held are terminal until the button is pressed again
+        constexpr bool CheckTerminalPhases() {
+            for (auto phase : { Consumed, Held }) {
+                for (auto input : { BlockInput::DelayElapsed, BlockInput::WindowElapsed, BlockInput::Consume }) {
+                    if (Next(phase, input) != phase) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        static_assert(CheckResetInputs());
+        static_assert(CheckTerminalPhases());
+        static_assert(Next(Idle, BlockInput::Consume) == Idle, "Consuming without a press must not open a window");
+        static_assert(Next(Delay, BlockInput::Consume) == Delay, "A hit during the delay must not consume the window");
+        static_assert(Advance(Delay, 0.04f, 0.05f, 0.3f) == Delay);
+        static_assert(Advance(Delay, 0.06f, 0.05f, 0.3f) == Window);
+        static_assert(Advance(Delay, 0.40f, 0.05f, 0.3f) == Held);
+        static_assert(Advance(Consumed, 0.10f, 0.05f, 0.3f) == Consumed);
+        static_assert(Classify(Delay) == BlockType::Regular, "A hit during the delay is a regular block");
+        static_assert(Classify(Window) == BlockType::Timed);
+
+    }
+
+}
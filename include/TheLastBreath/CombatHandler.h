@@ -16,6 +16,9 @@ namespace TheLastBreath {
 
         void OnActorHit(RE::Actor* victim, RE::Actor* aggressor, float actualDamage, BlockType blockType);
 
+        // Timed block against an arrow or bolt (projectile is the reference that hit, from the victim's last HitData)
+        void OnProjectileParried(RE::Actor* victim, RE::Actor* shooter, float actualDamage, RE::ObjectRefHandle projectile);
+
         // Block stamina drain
         void OnBlockStart(RE::Actor* actor);
         void OnBlockStop(RE::Actor* actor);
@@ -37,9 +40,16 @@ namespace TheLastBreath {
 
         bool ShouldProcessHit(RE::Actor* victim);
         float CalculateBaseStaminaLoss(RE::Actor* victim);
+        float GetBlockHoldCostPerSecond(RE::Actor* actor);
         void ProcessTimedBlock(RE::Actor* victim, RE::Actor* aggressor, float actualDamage);
-        void ProcessRegularBlock(RE::Actor* victim, float baseLoss);
-        void ProcessUnblockedHit(RE::Actor* victim, float baseLoss);
+
+        // Timed block damage reduction by healing back, for hits the pre-damage hook didn't reduce
+        void HealBackTimedBlockDamage(RE::Actor* victim, float actualDamage);
+
+        // fTimedBlockStaminaAmountLossMult / fTimedBlockStaminaAmountGain, shared by parries and deflections
+        void ApplyTimedBlockStamina(RE::Actor* victim);
+        void ProcessRegularBlock(RE::Actor* victim, RE::Actor* aggressor, float baseLoss);
+        void ProcessUnblockedHit(RE::Actor* victim, RE::Actor* aggressor, float baseLoss);
     };
 
 }
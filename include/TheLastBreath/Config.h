@@ -1,6 +1,8 @@
 #pragma once
 #include <array>
+#include <chrono>
 #include <filesystem>
+#include <string>
 
 namespace TheLastBreath {
     class Config {
@@ -13,84 +15,123 @@ namespace TheLastBreath {
         void Load();
         void Save();
 
+        // Current settings as INI text, in the same layout Save() writes
+        std::string Serialize() const;
+
+        static std::filesystem::path GetConfigPath();
+
+        // Every field below is described in the settings schema in Config.cpp,
+        // which owns its INI section, key, default and valid range.
+
         // ===== STAMINA =====
-        bool enableStaminaManagement = true;
-        bool enableJumpStaminaCost = true;
-        float jumpStaminaCost = 10.0f;
-        bool enableBlockStaminaDrain = true;
-        float blockHoldStaminaCostPerSecond = 2.0f;
+        bool enableStaminaManagement;
+        bool enableJumpStaminaCost;
+        float jumpStaminaCost;
+        bool enableBlockStaminaDrain;
+        float blockHoldStaminaCostPerSecond;
+        float blockHoldStaminaCostPerWeight;
 
         // Stamina Loss on Hit
-        bool enableStaminaLossOnHit = true;
-        float staminaLossBaseIntercept = 14.5f;
-        float staminaLossScalingFactor = 0.018f;
-        float staminaLossFlatAddition = 1.0f;
-        bool enableRegularBlockStaminaLossOnHit = true;
-        float regularBlockStaminaMult = 0.5f;
+        bool enableStaminaLossOnHit;
+        float staminaLossBaseIntercept;
+        float staminaLossScalingFactor;
+        float staminaLossFlatAddition;
+        bool enableRegularBlockStaminaLossOnHit;
+        float regularBlockStaminaMult;
+        float hitDeduplicationWindow;
 
         // Melee Weapons
-        bool enableLightAttackStamina = true;
-        float lightAttackStaminaCostMult = 0.15f;
+        bool enableLightAttackStamina;
+        float lightAttackStaminaCostMult;
+        bool closedFormAttackCost;
 
         // Ranged Weapons (Bow/Crossbow combined)
-        bool enableRangedStaminaCost = true;
-        bool enableRangedHoldStaminaDrain = true;
-        bool enableRangedReleaseStaminaCost = true;
-        float rangedHoldStaminaCostPerSecond = 3.0f;
-        float rangedReleaseStaminaCost = 10.0f;
-        bool enableRapidComboStaminaCost = false;
-        float rapidComboStaminaCost = 10.0f;
+        bool enableRangedStaminaCost;
+        bool enableRangedHoldStaminaDrain;
+        bool enableRangedReleaseStaminaCost;
+        float rangedHoldStaminaCostPerSecond;
+        float rangedHoldStaminaCostPerWeight;
+        float rangedReleaseStaminaCost;
+        bool enableRapidComboStaminaCost;
+        float rapidComboStaminaCost;
 
         // Exhaustion System
-        bool enableExhaustionDebuff = true;
-        float exhaustionStaminaThreshold = 20.0f;
-        float exhaustionMovementSpeedDebuff = 0.20f;      // 20% movement speed reduction
-        float exhaustionAttackDamageDebuff = 0.25f;       // 25% attack damage reduction
+        bool enableExhaustionDebuff;
+        float exhaustionStaminaThreshold;
+        float exhaustionMovementSpeedDebuff;
+        float exhaustionAttackDamageDebuff;
 
         // Timed Blocking System
-        bool enableTimedBlocking = true;
-        bool enableTimedBlockSkillRequirement = false;
-        float timedBlockRequiredSkillLevel = 0.0f;
-        float timedBlockWindow1 = 0.3f;   // Parry 1 (easiest)
-        float timedBlockWindow2 = 0.25f;  // Parry 2
-        float timedBlockWindow3 = 0.2f;   // Parry 3
-        float timedBlockWindow4 = 0.15f;  // Parry 4
-        float timedBlockWindow5 = 0.1f;   // Parry 5 (hardest - perfect parry)
-        float timedBlockAnimationDelay = 0.05f;
-        uint32_t blockButton = 257;
-        bool timedBlockStaminaLoss = false;
-        bool timedBlockStaminaGain = true;
-        float timedBlockStaminaAmountGain = 20.0f;
-        float timedBlockStaminaAmountLossMult = 0.5f;
-        float timedBlockDamageReduction = 1.0f;  // 1.0 = 100% damage reduction
-        bool slowTimeOnlyOnPerfectParry = true;   // Only on parry 5, or all parries?
-        float slowTimeDuration = 0.5f;            // Duration in seconds
-        float slowTimePercentage = 0.4f;          // Time speed (0.1 = 10% speed)
+        bool enableTimedBlocking;
+        bool enableTimedBlockSkillRequirement;
+        float timedBlockRequiredSkillLevel;
+        float timedBlockAnimationDelay;
+        uint32_t blockButton;
+        bool timedBlockStaminaLoss;
+        bool timedBlockStaminaGain;
+        float timedBlockStaminaAmountGain;
+        float timedBlockStaminaAmountLossMult;
+        float timedBlockDamageReduction;  // 1.0 = 100% damage reduction
+        bool usePreDamageHook;             // Reduce damage before it lands instead of healing it back
+        bool enableProjectileParry;
+        bool destroyParriedProjectiles;
+        bool slowTimeOnlyOnPerfectParry;   // Only on the final ladder level, or all parries?
+        float slowTimeDuration;            // Duration in seconds
+        float slowTimePercentage;          // Time speed (0.1 = 10% speed)
 
 
         // Parry Sequence System
-        bool enableParryStagger = true;
-        bool enablePerfectParry = true;
-        float parrySequenceTimeoutBase = 2.0f;           // Base timeout (5 seconds)
-        float parryStaggerMagnitude1 = 0.1f;             // Parry 1 stagger
-        float parryStaggerMagnitude2 = 0.2f;             // Parry 2 stagger
-        float parryStaggerMagnitude3 = 0.3f;             // Parry 3 stagger
-        float parryStaggerMagnitude4 = 0.4f;             // Parry 4 stagger
-        float perfectParryStaggerMagnitude = 10.0f;      // Perfect parry (5)
-        float parrySoundVolume = 1.0f;  // 0.0 = mute, 1.0 = full volume
-        bool enableParrySparks = true;  // Toggle visual sparks
+        bool enableParryStagger;
+        bool enablePerfectParry;
+        float parrySequenceTimeoutBase;
+        bool globalParryChain;
+        float parrySoundVolume;  // 0.0 = mute, 1.0 = full volume
+        bool enableParrySparks;  // Toggle visual sparks
 
 
         // Elden Counter Integration
-        bool enableEldenCounter = false;                    // Master toggle
-        bool eldenCounterOnlyTimedBlocks = true;            // Only on successful timed blocks
-        bool eldenCounterOnlyPerfectParry = false;          // Only on perfect parry (5th)
+        bool enableEldenCounter;                    // Master toggle
+        bool eldenCounterOnlyTimedBlocks;            // Only on successful timed blocks
+        bool eldenCounterOnlyPerfectParry;          // Only on perfect parry (5th)
+
+        // Frame Budget (cosmetic shedding)
+        bool enableFrameGovernor;
+        float frameBudgetMs;
+        float shedRingAt;           // Thresholds are multiples of the budget (frameBudgetMs or the recent average, if longer)
+        float shedSparksAt;
+        float shortenSlowTimeAt;
+        float shedSlowTimeMult;     // Slow time duration multiplier once shortened
 
         // ===== NPCS =====
-        bool applyToNPCs = true;
+        bool applyToNPCs;
 
         // ===== DEBUG =====
-        int logLevel = 1;  // 0=trace, 1=debug, 2=info, 3=warn, 4=error, 5=critical
+        int logLevel;  // 0=trace, 1=debug, 2=info, 3=warn, 4=error, 5=critical
+        bool enableMetrics;            // Counters/histograms written to TheLastBreath_Stats.txt
+        float metricsFlushInterval;    // Seconds between stats file writes
+        uint32_t profilerHotkey;       // Toggles a trace capture (TLB_ENABLE_PROFILER builds only)
+        float profilerCaptureDuration; // Seconds before a capture stops itself, 0 = until toggled
+        bool profilerCaptureOnLoad;    // Start a capture when a save is loaded
+        bool recordAttackCosts;        // Model inputs + engine power attack costs to TheLastBreath_AttackCosts.csv
+        bool recordSessions;           // Write a replayable TheLastBreath_Session_N.tlbr per loaded save
+        bool enableTelemetry;          // Per-encounter rows in TheLastBreath_Encounters.txt
+        bool exportSharedState;        // Live per-actor state in shared memory for overlays
+
+        // ===== DERIVED =====
+        // Recomputed from the settings above whenever they change (defaults and every Load),
+        // so per-hit and per-tick code reads one value instead of combining toggles and units
+        struct Derived {
+            bool blockDrain = false;            // Management + block drain
+            bool staminaLossOnHit = false;      // Management + loss on hit
+            bool jumpCost = false;              // Management + jump cost
+            bool rangedCost = false;            // Management + ranged costs
+            bool rangedHoldDrain = false;       // Management + ranged costs + hold drain
+            std::chrono::steady_clock::duration hitDeduplicationWindow{};  // Zero = same frame only
+            float shedRingMs = 0.0f;            // fFrameBudgetMs * fShedRingAt
+            float shedSparksMs = 0.0f;          // fFrameBudgetMs * fShedSparksAt
+            float shortenSlowTimeMs = 0.0f;     // fFrameBudgetMs * fShortenSlowTimeAt
+        };
+        Derived derived;
 
         // ===== BLOCK VISUAL EFFECTS (loaded from plugin) =====
         // Base activator for spawning FX
@@ -117,10 +158,10 @@ namespace TheLastBreath {
         //RE::FormID parryShieldSound4 = 0;
 
     private:
-        Config() = default;
+        Config();
         Config(const Config&) = delete;
         Config(Config&&) = delete;
 
-        static std::filesystem::path GetConfigPath();
+        void ComputeDerived();
     };
 }
\ No newline at end of file
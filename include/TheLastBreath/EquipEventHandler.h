@@ -0,0 +1,23 @@
+#pragma once
+
+namespace TheLastBreath {
+
+    // Invalidates per-actor caches that depend on equipped items
+    class EquipEventHandler : public RE::BSTEventSink<RE::TESEquipEvent> {
+    public:
+        static EquipEventHandler* GetSingleton() {
+            static EquipEventHandler singleton;
+            return &singleton;
+        }
+
+        RE::BSEventNotifyControl ProcessEvent(
+            const RE::TESEquipEvent* a_event,
+            RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource) override;
+
+    private:
+        EquipEventHandler() = default;
+        EquipEventHandler(const EquipEventHandler&) = delete;
+        EquipEventHandler(EquipEventHandler&&) = delete;
+    };
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    enum EquipFlag : std::uint8_t {
+        kEquipRightWeapon = 1 << 0,
+        kEquipLeftWeapon = 1 << 1,
+        kEquipLeftArmor = 1 << 2,    // Shield (any armor in the left hand)
+        kEquipRanged = 1 << 3        // Bow or crossbow in the right hand
+    };
+
+    struct Equipment {
+        RE::FormID right = 0;
+        RE::FormID left = 0;
+        std::uint8_t flags = 0;      // EquipFlag
+
+        bool HasShield() const { return flags & kEquipLeftArmor; }
+        bool HasRanged() const { return flags & kEquipRanged; }
+        bool CanBlock() const { return flags & (kEquipRightWeapon | kEquipLeftWeapon | kEquipLeftArmor); }
+    };
+
+    // What each actor holds in either hand, kept as a couple of FormIDs and a bitfield so
+    // per-tick and per-input checks don't go through GetEquippedObject and form casts.
+    // Captured on first use and refreshed from TESEquipEvent: the event can arrive before
+    // the hand slots change, so an actor is re-read on every lookup for a short time after it.
+    // Entries live in a fixed direct-mapped table; an actor whose slot was taken is captured again.
+    class EquipmentSnapshot {
+    public:
+        static EquipmentSnapshot* GetSingleton() {
+            static EquipmentSnapshot singleton;
+            return &singleton;
+        }
+
+        Equipment Get(RE::Actor* actor);
+
+        // False while the actor's hands may still change after an equip event
+        bool IsSettled(RE::FormID formID);
+
+        void OnEquipChanged(RE::FormID formID);
+        void ClearAll();
+
+    private:
+        EquipmentSnapshot() = default;
+        EquipmentSnapshot(const EquipmentSnapshot&) = delete;
+        EquipmentSnapshot(EquipmentSnapshot&&) = delete;
+
+        static constexpr auto kSettleTime = std::chrono::milliseconds(500);
+
+        static constexpr std::size_t kSlotBits = 8;
+
+        static constexpr std::size_t SlotOf(RE::FormID formID) {
+            return static_cast<std::size_t>((formID * 0x9E3779B1u) >> (32 - kSlotBits));
+        }
+
+        struct Entry {
+            RE::FormID formID = 0;   // 0 = empty slot
+            bool captured = false;   // False when an equip event claimed the slot before any lookup
+            Equipment equipment;
+            std::chrono::steady_clock::time_point volatileUntil;  // Re-read until then
+        };
+
+        static Equipment Capture(RE::Actor* actor);
+
+        std::mutex mutex;
+        std::array<Entry, std::size_t{ 1 } << kSlotBits> entries{};
+    };
+
+}
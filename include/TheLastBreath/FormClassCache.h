@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace TheLastBreath {
+
+    enum class FormClass : std::uint8_t {
+        Unknown,
+        MeleeWeapon,    // Every non-ranged weapon, staves included
+        RangedWeapon,   // Bow or crossbow
+        Projectile,
+        Spell,          // Spells, scrolls and enchantments
+        Other
+    };
+
+    // FormID -> FormClass for hit filtering and equipment classification.
+    // Weapons, projectiles and spells are collected once at kDataLoaded into a sorted array
+    // that is never written again; anything else is classified on first sight and kept in
+    // an insert-only open addressing table. Reads take no locks.
+    class FormClassCache {
+    public:
+        static FormClassCache* GetSingleton() {
+            static FormClassCache singleton;
+            return &singleton;
+        }
+
+        void Build();
+
+        FormClass Classify(RE::FormID formID);
+        FormClass Classify(const RE::TESForm* form);
+
+        static constexpr bool IsWeapon(FormClass formClass) {
+            return formClass == FormClass::MeleeWeapon || formClass == FormClass::RangedWeapon;
+        }
+
+    private:
+        FormClassCache() = default;
+        FormClassCache(const FormClassCache&) = delete;
+        FormClassCache(FormClassCache&&) = delete;
+
+        struct Entry {
+            RE::FormID formID;
+            FormClass formClass;
+        };
+
+        static constexpr std::size_t kLateSlots = 4096;  // Power of two
+        static constexpr std::size_t kMaxProbes = 16;
+
+        static FormClass ClassifyForm(const RE::TESForm* form);
+
+        FormClass FindLate(RE::FormID formID) const;
+        void AddLate(RE::FormID formID, FormClass formClass);
+
+        std::vector<Entry> entries;  // Sorted by FormID, read only once built
+        std::atomic<bool> built = false;
+
+        // (FormID << 8) | FormClass per slot, 0 = empty
+        std::array<std::atomic<std::uint64_t>, kLateSlots> lateEntries{};
+    };
+
+}
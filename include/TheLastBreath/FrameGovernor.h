@@ -0,0 +1,48 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+
+namespace TheLastBreath {
+
+    // Which cosmetic parts of a parry to play. Stagger, stamina and sound are never shed.
+    struct CosmeticPlan {
+        bool ring = true;
+        bool sparks = true;           // Spark, flare and the FX activator they are spawned from
+        float slowTimeScale = 1.0f;   // Multiplier on fSlowTimeDuration
+    };
+
+    // Tracks recent frame times and what the parry cosmetics cost on the main thread,
+    // and sheds cosmetics when a parry would land on a frame that is already over budget.
+    // The budget is fFrameBudgetMs or the player's own average frame time over the last few
+    // seconds, whichever is longer, so a machine that always runs below the target frame rate
+    // only sheds on spikes. Each cosmetic has its own threshold (a multiple of the budget),
+    // which sets the shedding order.
+    class FrameGovernor {
+    public:
+        static FrameGovernor* GetSingleton() {
+            static FrameGovernor singleton;
+            return &singleton;
+        }
+
+        void Sample();  // Reads the last frame time from BSTimer
+        void RecordCosmeticCost(std::chrono::steady_clock::duration cost);
+
+        CosmeticPlan Plan();
+
+        float GetFrameTimeMs() const { return frameTimeMs.load(std::memory_order_relaxed); }
+        float GetCosmeticCostMs() const { return cosmeticCostMs.load(std::memory_order_relaxed); }
+        float GetBaselineMs() const { return baselineMs.load(std::memory_order_relaxed); }
+
+    private:
+        FrameGovernor() = default;
+        FrameGovernor(const FrameGovernor&) = delete;
+        FrameGovernor(FrameGovernor&&) = delete;
+
+        // Exponential moving averages. Writers race only with themselves on
+        // different threads, and a lost sample doesn't matter for an average.
+        std::atomic<float> frameTimeMs = 0.0f;
+        std::atomic<float> cosmeticCostMs = 0.0f;
+        std::atomic<float> baselineMs = 0.0f;   // Slow average, the frame rate the player normally gets
+    };
+
+}
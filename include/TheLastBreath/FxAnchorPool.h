@@ -0,0 +1,42 @@
+#pragma once
+#include <array>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    // A few BlockFX activator references that parry explosions are placed from.
+    // Anchors are created on first use and moved to the blocker's weapon/shield node for
+    // each parry instead of being spawned and deleted every time. An anchor whose reference
+    // was cleaned up with its cell is simply created again.
+    // Everything is placed through TESDataHandler rather than the Papyrus PlaceAtMe native.
+    class FxAnchorPool {
+    public:
+        static FxAnchorPool* GetSingleton() {
+            static FxAnchorPool singleton;
+            return &singleton;
+        }
+
+        // Next anchor, moved to node (or to the blocker when there is no node). Main thread only.
+        RE::NiPointer<RE::TESObjectREFR> Acquire(RE::Actor* blocker, RE::NiAVObject* node);
+
+        static bool PlaceExplosion(RE::TESObjectREFR* anchor, RE::BGSExplosion* explosion);
+
+        // Deletes the anchors that are still around. Called before a save is written and
+        // before another save loads, while the handles still point at our references
+        void ClearAll();
+
+    private:
+        FxAnchorPool() = default;
+        FxAnchorPool(const FxAnchorPool&) = delete;
+        FxAnchorPool(FxAnchorPool&&) = delete;
+
+        // Explosions are placed the moment the anchor is in position, so one anchor per
+        // blocker that can parry in the same frame is plenty
+        static constexpr std::size_t kAnchors = 4;
+
+        std::mutex mutex;
+        std::array<RE::ObjectRefHandle, kAnchors> anchors{};
+        std::size_t next = 0;
+    };
+
+}
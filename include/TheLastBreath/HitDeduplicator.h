@@ -0,0 +1,57 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    // Drops repeat TESHitEvents for what is one strike on screen - sweeping attacks,
+    // multi-hit projectiles and duplicate event delivery. Each victim keeps a small
+    // ring of recent hit signatures built from the event's own fields (aggressor, source,
+    // projectile, hit flags). A signature seen again in the same frame is a duplicate;
+    // fHitDeduplicationWindow optionally extends that to repeats a little later, at the
+    // cost of merging real strikes that close together. Events carry nothing that tells
+    // two strikes with identical fields in one frame apart, so those always merge.
+    // Rings live in a fixed table; a new victim takes the ring that was hit longest ago.
+    class HitDeduplicator {
+    public:
+        static HitDeduplicator* GetSingleton() {
+            static HitDeduplicator singleton;
+            return &singleton;
+        }
+
+        // Records the hit and returns true if the same signature was already seen this frame or inside the window.
+        // frame is any value that is the same for every event dispatched in one frame and differs between frames.
+        bool IsDuplicate(RE::FormID victim, RE::FormID aggressor, RE::FormID source, RE::FormID projectile,
+            std::uint8_t flags, std::uint64_t frame);
+
+        void ClearAll();
+
+    private:
+        HitDeduplicator() = default;
+        HitDeduplicator(const HitDeduplicator&) = delete;
+        HitDeduplicator(HitDeduplicator&&) = delete;
+
+        static constexpr std::size_t kRingSize = 8;
+        static constexpr std::size_t kMaxVictims = 64;
+
+        struct Signature {
+            std::uint64_t key = 0;  // 0 = empty slot
+            std::uint64_t frame = 0;
+            std::chrono::steady_clock::time_point time;
+        };
+
+        struct Ring {
+            RE::FormID victim = 0;  // 0 = free
+            std::chrono::steady_clock::time_point lastHit;
+            std::array<Signature, kRingSize> entries{};
+            std::size_t next = 0;
+        };
+
+        Ring& Acquire(RE::FormID victim);
+
+        std::mutex mutex;
+        std::array<Ring, kMaxVictims> rings{};
+    };
+
+}
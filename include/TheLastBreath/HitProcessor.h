@@ -13,6 +13,9 @@ namespace TheLastBreath {
         // Returns true if this was a timed block
         bool ProcessHit(RE::Actor* aggressor, RE::Actor* victim, RE::HitData& hitData);
 
+        // Disables a parried arrow or bolt on the next task run, when bDestroyParriedProjectiles is set
+        static void DestroyProjectile(RE::ObjectRefHandle projectile);
+
     private:
         HitProcessor() = default;
         HitProcessor(const HitProcessor&) = delete;
@@ -2,6 +2,7 @@
 
 namespace TheLastBreath {
     namespace Hooks {
-        void Install();           // Attack stamina cost hook
+        void Install();           // Attack stamina cost hook (+ hit hook when enabled)
+        void InstallHitHook();    // Pre-damage timed block reduction
     }
 }
@@ -0,0 +1,207 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+namespace TheLastBreath {
+
+    enum class Counter : std::uint8_t {
+        HitEvents,          // Weapon/projectile hits seen by HitEventHandler
+        PreDamageHits,      // Hits seen by the pre-damage hit hook
+        TimedBlocks,
+        PerfectParries,
+        Staggers,
+        BlockDrainTicks,
+        RangedDrainTicks,
+        AttackCostQueries,
+        CosmeticsShed,      // Parries that dropped or shortened cosmetics for the frame budget
+        DuplicateHits,      // Hit events dropped by HitDeduplicator
+        ProjectileParries,  // Arrows and bolts deflected by a timed block
+
+        kCount
+    };
+
+    enum class Gauge : std::uint8_t {
+        TimedBlockActors,
+        BlockEffectsActors,
+        BlockDrainActors,
+        RangedDrainActors,
+        ExhaustedActors,
+
+        kCount
+    };
+
+    // Latency histograms, all recorded in microseconds
+    enum class Histogram : std::uint8_t {
+        AttackCostHook,
+        ProcessHitHook,
+        HitEvent,
+        UpdatePass,
+
+        // Parry pipeline (see ParryLatency)
+        PressToWindowOpen,
+        PressToHookDecision,
+        HookDecisionToConfirm,
+        ConfirmToEffects,
+        PressToEffects,
+
+        kCount
+    };
+
+    // Log-linear bucket layout: exact below 4us, then 4 buckets per power of two.
+    // 128 buckets cover up to ~2 hours with <= 25% bucket width error.
+    namespace HistogramBuckets {
+
+        inline constexpr std::uint32_t kSubBits = 2;
+        inline constexpr std::uint32_t kSubCount = 1u << kSubBits;
+        inline constexpr std::size_t kCount = 128;
+
+        constexpr std::size_t IndexOf(std::uint64_t micros) {
+            if (micros < kSubCount) {
+                return static_cast<std::size_t>(micros);
+            }
+            auto msb = static_cast<std::uint32_t>(std::bit_width(micros)) - 1;
+            auto sub = static_cast<std::size_t>((micros >> (msb - kSubBits)) & (kSubCount - 1));
+            auto index = (msb - kSubBits + 1) * kSubCount + sub;
+            return std::min<std::size_t>(index, kCount - 1);
+        }
+
+        constexpr std::uint64_t LowerBound(std::size_t index) {
+            if (index < kSubCount) {
+                return index;
+            }
+            auto msb = static_cast<std::uint32_t>(index / kSubCount) + kSubBits - 1;
+            auto sub = static_cast<std::uint64_t>(index % kSubCount);
+            return (kSubCount + sub) << (msb - kSubBits);
+        }
+
+        static_assert(IndexOf(3) == 3);
+        static_assert(IndexOf(4) == 4 && IndexOf(7) == 7);
+        static_assert(IndexOf(8) == 8 && IndexOf(9) == 8 && IndexOf(10) == 9);
+        static_assert(LowerBound(IndexOf(1000)) <= 1000 && LowerBound(IndexOf(1000) + 1) > 1000);
+        static_assert(IndexOf(~0ull) == kCount - 1);
+    }
+
+    // Aggregated histogram, produced on demand from the per-thread shards
+    struct HistogramSnapshot {
+        std::array<std::uint64_t, HistogramBuckets::kCount> buckets{};
+        std::uint64_t count = 0;
+        std::uint64_t sum = 0;
+        std::uint64_t max = 0;
+
+        // Lower bound of the bucket holding the given percentile (0-100)
+        std::uint64_t Percentile(double percentile) const {
+            if (count == 0) return 0;
+            auto target = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(count - 1)) + 1;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < buckets.size(); ++i) {
+                seen += buckets[i];
+                if (seen >= target) {
+                    return HistogramBuckets::LowerBound(i);
+                }
+            }
+            return max;
+        }
+
+        double Mean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+    };
+
+    // Lock-free metrics registry. Writers touch only their own shard with relaxed
+    // atomics; shards are summed when the stats file is written.
+    class Metrics {
+    public:
+        static Metrics* GetSingleton() {
+            static Metrics singleton;
+            return &singleton;
+        }
+
+        bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+        void SetEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+
+        void Increment(Counter counter, std::uint64_t amount = 1) {
+            if (!IsEnabled()) return;
+            LocalShard().counters[static_cast<std::size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        void SetGauge(Gauge gauge, std::int64_t value) {
+            if (!IsEnabled()) return;
+            gauges[static_cast<std::size_t>(gauge)].store(value, std::memory_order_relaxed);
+        }
+
+        void RecordParryLevel(std::uint32_t level);
+        void Record(Histogram histogram, std::uint64_t micros);
+
+        // Times the enclosing scope into a histogram
+        class ScopedTimer {
+        public:
+            explicit ScopedTimer(Histogram a_histogram) :
+                histogram(a_histogram),
+                active(Metrics::GetSingleton()->IsEnabled()) {
+                if (active) start = std::chrono::steady_clock::now();
+            }
+
+            ~ScopedTimer() {
+                if (!active) return;
+                auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+                Metrics::GetSingleton()->Record(histogram, static_cast<std::uint64_t>(elapsed.count()));
+            }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+        private:
+            Histogram histogram;
+            bool active;
+            std::chrono::steady_clock::time_point start;
+        };
+
+        // Called from the update worker - writes the stats file once per flush interval
+        void Tick();
+
+        // Write the stats file now
+        void Flush();
+
+        std::uint64_t SumCounter(Counter counter) const;
+        HistogramSnapshot Snapshot(Histogram histogram) const;
+
+    private:
+        Metrics();
+        Metrics(const Metrics&) = delete;
+        Metrics(Metrics&&) = delete;
+
+        static constexpr std::size_t kShardCount = 8;
+        static constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::kCount);
+        static constexpr std::size_t kGaugeCount = static_cast<std::size_t>(Gauge::kCount);
+        static constexpr std::size_t kHistogramCount = static_cast<std::size_t>(Histogram::kCount);
+        static constexpr std::size_t kMaxParryLevels = 16;
+
+        struct HistogramShard {
+            std::array<std::atomic<std::uint64_t>, HistogramBuckets::kCount> buckets{};
+            std::atomic<std::uint64_t> sum{ 0 };
+            std::atomic<std::uint64_t> max{ 0 };
+        };
+
+        // One cache line aligned shard per group of threads
+        struct alignas(64) Shard {
+            std::array<std::atomic<std::uint64_t>, kCounterCount> counters{};
+            std::array<std::atomic<std::uint64_t>, kMaxParryLevels> parryLevels{};
+            std::array<HistogramShard, kHistogramCount> histograms{};
+        };
+
+        std::atomic<bool> enabled{ false };
+        std::array<Shard, kShardCount> shards{};
+        std::array<std::atomic<std::int64_t>, kGaugeCount> gauges{};
+        std::atomic<std::size_t> nextShard{ 0 };
+
+        std::chrono::steady_clock::time_point startTime;
+        std::chrono::steady_clock::time_point lastFlush;
+        std::filesystem::path statsPath;
+
+        Shard& LocalShard();
+    };
+
+}
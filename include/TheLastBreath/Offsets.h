@@ -3,18 +3,6 @@
 namespace TheLastBreath {
     namespace Offsets {
 
-        // Valhalla's PlaceAtMe wrapper
-        inline RE::TESObjectREFR* PlaceAtMe(RE::TESObjectREFR* self, RE::TESForm* a_form, std::uint32_t count, bool forcePersist, bool initiallyDisabled)
-        {
-            using func_t = RE::TESObjectREFR* (RE::BSScript::Internal::VirtualMachine*, RE::VMStackID, RE::TESObjectREFR*, RE::TESForm*, std::uint32_t, bool, bool);
-            RE::VMStackID frame = 0;
-
-            REL::Relocation<func_t> func{ RELOCATION_ID(55672, 56203) };
-            auto vm = RE::BSScript::Internal::VirtualMachine::GetSingleton();
-
-            return func(vm, frame, self, a_form, count, forcePersist, initiallyDisabled);
-        }
-
         // PushActorAway (for guard break / perfect parry)
         typedef void(_fastcall* tPushActorAway)(RE::AIProcess* a_causer, RE::Actor* a_target, RE::NiPoint3& a_origin, float a_magnitude);
         inline static REL::Relocation<tPushActorAway> PushActorAway{ RELOCATION_ID(38858, 39895) };
@@ -23,6 +11,21 @@ namespace TheLastBreath {
         typedef void(_fastcall* tStaggerActor)(RE::Actor* a_target, RE::Actor* a_aggressor, float a_magnitude);
         inline static REL::Relocation<tStaggerActor> StaggerActor{ RELOCATION_ID(36700, 37710) };
 
+        // Unscaled length of the last frame in seconds (slow time doesn't change it)
+        inline float GetRealTimeDelta() {
+            REL::Relocation<RE::BSTimer**> singleton{ RELOCATION_ID(523657, 410196) };
+            auto timer = *singleton;
+            return timer ? timer->realTimeDelta : 0.0f;
+        }
+
+        // Performance counter taken at the start of the current frame - the same for everything
+        // the main thread runs in one frame
+        inline std::uint64_t GetFrameStamp() {
+            REL::Relocation<RE::BSTimer**> singleton{ RELOCATION_ID(523657, 410196) };
+            auto timer = *singleton;
+            return timer ? timer->lastPerformanceCount : 0;
+        }
+
         // Set BSTimer function
         inline void SGTM(float a_multiplier, bool a_useSmoothing = true) {
             // Access BSTimer singleton directly
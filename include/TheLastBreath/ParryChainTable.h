@@ -0,0 +1,119 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace TheLastBreath {
+
+    // Parry sequence counts keyed by (blocker, aggressor), in a fixed table of kMaxChains
+    // slots so starting or ending a chain never allocates. Chains are found through an
+    // open-addressed index and kept in a min-heap on their expiry time, so a lookup is a
+    // couple of probes and expired chains are popped off the heap front instead of being
+    // searched for. A new pair that finds every slot live evicts the chain closest to expiring.
+    // Each blocker with a live chain also has a record of the aggressor it parried last.
+    // Not thread safe - the owner serializes access.
+    class ParryChainTable {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t kMaxChains = 64;
+
+        ParryChainTable() { Clear(); }
+
+        // Parries landed in the live chain, 0 if there is none or it expired
+        std::uint32_t GetCount(RE::FormID blocker, RE::FormID aggressor, Clock::time_point now);
+
+        // Same, for the aggressor the blocker's last Set() named
+        std::uint32_t GetLastCount(RE::FormID blocker, Clock::time_point now);
+
+        // True if aggressor is the one the blocker's last Set() named, or the blocker has no live chain
+        bool IsLastAggressor(RE::FormID blocker, RE::FormID aggressor) const;
+
+        // count 0 ends the chain. Either way aggressor becomes the blocker's last one.
+        void Set(RE::FormID blocker, RE::FormID aggressor, std::uint32_t count,
+            Clock::time_point now, Clock::time_point expiresAt);
+
+        // Ends the chain without touching the blocker's last aggressor. False if there was none.
+        bool End(RE::FormID blocker, RE::FormID aggressor, Clock::time_point now);
+
+        // False if the blocker had no live chain
+        bool ClearBlocker(RE::FormID blocker);
+        void Clear();
+
+        std::size_t Size() const { return heapSize; }
+        std::size_t Blockers() const { return blockerCount; }
+
+    private:
+        using Slot = std::uint8_t;
+
+        static constexpr std::size_t kIndexBits = 7;
+        static constexpr std::size_t kIndexSize = std::size_t{ 1 } << kIndexBits;  // Kept at most half full
+        static_assert(kMaxChains * 2 <= kIndexSize && kMaxChains <= 255);
+
+        struct Chain {
+            std::uint64_t key = 0;  // 0 = free slot (the blocker is never FormID 0)
+            std::uint32_t count = 0;
+            Slot heapPos = 0;
+            Slot blockerSlot = 0;
+            Clock::time_point expiresAt;
+        };
+
+        struct Blocker {
+            RE::FormID formID = 0;  // 0 = free slot
+            RE::FormID lastAggressor = 0;
+            Slot chains = 0;        // Live chains of this blocker; the record goes with the last one
+        };
+
+        // Linear probing over slot + 1 (0 = empty bucket), removal by backward shift so
+        // lookups never walk tombstones
+        struct Index {
+            std::array<Slot, kIndexSize> buckets{};
+
+            static std::size_t Home(std::uint64_t key) {
+                return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> (64 - kIndexBits));
+            }
+
+            template <class KeyOf>
+            const Slot* Find(std::uint64_t key, KeyOf keyOf) const;
+
+            void Insert(std::uint64_t key, Slot slot);
+
+            template <class KeyOf>
+            void Erase(std::uint64_t key, KeyOf keyOf);
+        };
+
+        static constexpr std::uint64_t MakeKey(RE::FormID blocker, RE::FormID aggressor) {
+            return (static_cast<std::uint64_t>(blocker) << 32) | aggressor;
+        }
+
+        Chain* FindChain(std::uint64_t key);
+        Blocker* FindBlocker(RE::FormID formID);
+        const Blocker* FindBlocker(RE::FormID formID) const;
+        Slot AcquireBlocker(RE::FormID formID);
+
+        void Free(Slot slot);
+        void Reclaim(Clock::time_point now);
+
+        // Heap of chain slots ordered by expiresAt
+        void HeapSwap(std::size_t a, std::size_t b);
+        void SiftUp(std::size_t pos);
+        void SiftDown(std::size_t pos);
+        void HeapRemove(std::size_t pos);
+
+        std::array<Chain, kMaxChains> chains{};
+        std::array<Blocker, kMaxChains> blockers{};
+        Index chainIndex;
+        Index blockerIndex;
+
+        std::array<Slot, kMaxChains> heap{};
+        std::size_t heapSize = 0;
+
+        // Free slots are handed out from the top
+        std::array<Slot, kMaxChains> freeChains{};
+        std::array<Slot, kMaxChains> freeBlockers{};
+        std::size_t freeChainCount = 0;
+        std::size_t freeBlockerCount = 0;
+        std::size_t blockerCount = 0;
+    };
+
+}
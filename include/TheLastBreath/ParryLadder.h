@@ -0,0 +1,65 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+
+namespace TheLastBreath {
+
+    // One rung of the consecutive parry ladder
+    struct ParryLevel {
+        float window = 0.0f;               // Timed block window while this level is next
+        float staggerMagnitude = 0.0f;     // Stagger applied to the aggressor (guard break on the final level)
+        float timeoutIncrement = 0.0f;     // Extra seconds added to the sequence timeout once this level lands
+
+        RE::FormID weaponSoundID = 0;      // Sound descriptors in TheLastBreath.esp
+        RE::FormID shieldSoundID = 0;
+
+        bool spark = true;                 // Spark explosions spawned on the weapon/shield node
+        bool flare = true;
+        bool ring = false;
+
+        // Resolved from the IDs above at kDataLoaded
+        RE::BGSSoundDescriptorForm* weaponSound = nullptr;
+        RE::BGSSoundDescriptorForm* shieldSound = nullptr;
+    };
+
+    // Variable length parry progression. Level 1 is the first parry of a sequence,
+    // the final level is the perfect parry / guard break.
+    class ParryLadder {
+    public:
+        static ParryLadder* GetSingleton() {
+            static ParryLadder singleton;
+            return &singleton;
+        }
+
+        static constexpr uint32_t kMaxLevels = 16;
+
+        // Read [ParryLadder] sections and resolve sound forms (call at kDataLoaded)
+        void Load();
+
+        uint32_t GetLevelCount() const { return static_cast<uint32_t>(levels.size()); }
+
+        // 1-based, clamped to the ladder
+        const ParryLevel& GetLevel(uint32_t level) const {
+            return levels[std::clamp<uint32_t>(level, 1, GetLevelCount()) - 1];
+        }
+
+        bool IsFinalLevel(uint32_t level) const { return level >= GetLevelCount(); }
+
+        // Sequence timeout after `consecutiveCount` parries have landed
+        float GetTimeout(float baseTimeout, uint32_t consecutiveCount) const {
+            return baseTimeout + cumulativeTimeout[std::min<std::size_t>(consecutiveCount, cumulativeTimeout.size() - 1)];
+        }
+
+    private:
+        ParryLadder();
+        ParryLadder(const ParryLadder&) = delete;
+        ParryLadder(ParryLadder&&) = delete;
+
+        // Loaded once at kDataLoaded and read-only afterwards
+        std::vector<ParryLevel> levels;
+        std::vector<float> cumulativeTimeout;   // [n] = sum of the first n increments
+
+        void Rebuild();
+    };
+
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    // Checkpoints along the parry pipeline, in the order they normally happen
+    enum class ParryStage : std::uint8_t {
+        Press,          // Block button pressed (InputEventHandler)
+        WindowOpen,     // TimedBlockHandler first sees the window open
+        HookDecision,   // Pre-damage hit hook decided the hit is a timed block
+        HitConfirmed,   // HitEventHandler classified the hit as a timed block
+        EffectsIssued,  // BlockEffectsHandler issued sound/FX/stagger
+
+        kCount
+    };
+
+    // Timestamps each stage per actor and feeds stage-to-stage latencies into
+    // the metrics histograms (reported with p50/p95/p99 in the stats file).
+    // Traces live in a fixed table; a new actor takes the slot of the stalest press.
+    class ParryLatency {
+    public:
+        static ParryLatency* GetSingleton() {
+            static ParryLatency singleton;
+            return &singleton;
+        }
+
+        void Checkpoint(RE::Actor* actor, ParryStage stage);
+        void ClearActor(RE::Actor* actor);
+
+    private:
+        ParryLatency() = default;
+        ParryLatency(const ParryLatency&) = delete;
+        ParryLatency(ParryLatency&&) = delete;
+
+        using TimePoint = std::chrono::steady_clock::time_point;
+
+        static constexpr std::size_t kMaxTraces = 16;
+
+        struct Trace {
+            RE::FormID formID = 0;  // 0 = free slot
+            std::array<TimePoint, static_cast<std::size_t>(ParryStage::kCount)> stamps{};
+        };
+
+        Trace& Acquire(RE::FormID formID);
+
+        std::array<Trace, kMaxTraces> traces{};
+        std::mutex tracesMutex;
+    };
+
+}
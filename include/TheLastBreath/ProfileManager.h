@@ -0,0 +1,96 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace TheLastBreath {
+
+    // Equipment class used to pick a profile column.
+    // Weapon entries mirror RE::WEAPON_TYPE so the cast is direct.
+    enum class EquipClass : uint8_t {
+        HandToHand,
+        Sword,
+        Dagger,
+        WarAxe,
+        Mace,
+        Greatsword,
+        Battleaxe,
+        Bow,
+        Staff,
+        Crossbow,
+        Shield,
+
+        kCount
+    };
+
+    // Tunables that can be overridden per equipment class and race/keyword
+    struct Profile {
+        float timedBlockWindowMult = 1.0f;            // Scales every timed block window
+        float parryStaggerMult = 1.0f;                // Scales parry stagger applied TO this actor
+        float blockHoldStaminaCostPerSecond = 0.0f;
+        float rangedHoldStaminaCostPerSecond = 0.0f;
+        float lightAttackStaminaCostMult = 0.0f;
+    };
+
+    class ProfileManager {
+    public:
+        static ProfileManager* GetSingleton() {
+            static ProfileManager singleton;
+            return &singleton;
+        }
+
+        // Parse [Profile.*] sections and build the lookup table (call at kDataLoaded)
+        void Compile();
+
+        // Effective profile for an actor. Takes no locks once cached; which profile an actor
+        // uses is cached until equipment or combat state changes, and not at all while the
+        // actor's equipment snapshot is still settling after an equip event
+        Profile GetProfile(RE::Actor* actor);
+
+        // Drop the cached profile so the next lookup re-resolves it
+        void InvalidateActor(RE::FormID formID);
+        void ClearAll();
+
+        static EquipClass GetEquipClass(RE::Actor* actor);
+
+    private:
+        ProfileManager() = default;
+        ProfileManager(const ProfileManager&) = delete;
+        ProfileManager(ProfileManager&&) = delete;
+
+        static constexpr std::size_t kEquipClassCount = static_cast<std::size_t>(EquipClass::kCount);
+        static constexpr std::size_t kCacheSlots = 1024;  // Power of two
+
+        // Everything Compile() produces. Never modified once published.
+        struct Table {
+            // Dense table: [bucket][equipClass], bucket 0 = no race/keyword match
+            std::vector<Profile> profiles;
+            std::size_t bucketCount = 1;
+
+            // Race -> bucket, and keywords checked in INI order for actors whose race has no bucket
+            std::unordered_map<RE::FormID, std::uint32_t> raceBuckets;
+            std::vector<std::pair<RE::BGSKeyword*, std::uint32_t>> keywordBuckets;
+
+            std::uint16_t generation = 0;  // Cache entries from older tables never match
+        };
+
+        std::atomic<const Table*> table = nullptr;
+        std::vector<std::unique_ptr<const Table>> tables;  // Every published table - a reader may still hold an old one
+        std::mutex publishMutex;                           // Writers only
+
+        // Direct mapped (FormID << 32) | (generation << 16) | (profile index + 1), 0 = empty.
+        // Colliding actors evict each other, so the cache never grows.
+        std::array<std::atomic<std::uint64_t>, kCacheSlots> actorProfiles{};
+
+        const Table* GetTable();
+        const Table* Publish(std::unique_ptr<Table> next, bool replace);
+
+        static std::uint32_t GetBucket(const Table& current, RE::Actor* actor);
+        static std::size_t Resolve(const Table& current, RE::Actor* actor);
+    };
+
+}
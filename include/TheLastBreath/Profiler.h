@@ -0,0 +1,102 @@
+#pragma once
+
+// Span profiler producing Chrome trace-event JSON (chrome://tracing, Perfetto, Speedscope).
+// Only built with -DTLB_ENABLE_PROFILER=ON; otherwise TLB_PROFILE_SCOPE expands to nothing.
+
+#define TLB_PROFILE_CONCAT_INNER(a, b) a##b
+#define TLB_PROFILE_CONCAT(a, b) TLB_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef TLB_ENABLE_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// `name` must be a string literal - only the pointer is stored
+#define TLB_PROFILE_SCOPE(name) ::TheLastBreath::Profiler::Span TLB_PROFILE_CONCAT(tlbProfileSpan, __LINE__){ name }
+
+namespace TheLastBreath {
+
+    class Profiler {
+    public:
+        static Profiler* GetSingleton() {
+            static Profiler singleton;
+            return &singleton;
+        }
+
+        bool IsCapturing() const { return capturing.load(std::memory_order_relaxed); }
+
+        void StartCapture();
+        void StopCapture();
+        void ToggleCapture();
+
+        // Called from the update worker: ends timed captures and writes finished ones to disk
+        void Tick();
+
+        // RAII span - costs one relaxed load when no capture is running
+        class Span {
+        public:
+            explicit Span(const char* a_name) :
+                name(a_name),
+                active(Profiler::GetSingleton()->IsCapturing()) {
+                if (active) start = std::chrono::steady_clock::now();
+            }
+
+            ~Span() {
+                if (active) Profiler::GetSingleton()->Record(name, start, std::chrono::steady_clock::now());
+            }
+
+            Span(const Span&) = delete;
+            Span& operator=(const Span&) = delete;
+
+        private:
+            const char* name;
+            bool active;
+            std::chrono::steady_clock::time_point start;
+        };
+
+    private:
+        Profiler() = default;
+        Profiler(const Profiler&) = delete;
+        Profiler(Profiler&&) = delete;
+
+        static constexpr std::size_t kMaxEventsPerThread = 1 << 16;
+
+        struct Event {
+            const char* name;
+            std::chrono::steady_clock::time_point start;
+            std::chrono::steady_clock::time_point end;
+        };
+
+        // Written only by its owning thread; count is published with release
+        struct ThreadBuffer {
+            std::uint32_t threadIndex = 0;
+            std::unique_ptr<Event[]> events = std::make_unique<Event[]>(kMaxEventsPerThread);
+            std::atomic<std::size_t> count{ 0 };
+            std::atomic<std::size_t> dropped{ 0 };
+        };
+
+        std::atomic<bool> capturing{ false };
+        std::atomic<bool> pendingWrite{ false };
+        std::chrono::steady_clock::time_point captureStart;
+        std::chrono::steady_clock::time_point captureStop;
+        std::uint32_t captureNumber = 0;
+
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;  // Never shrinks - threads keep raw pointers
+        std::mutex buffersMutex;                             // Registration, capture start/stop and writing
+
+        void Record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end);
+        ThreadBuffer* LocalBuffer();
+        void WriteTrace();
+    };
+
+}
+
+#else
+
+#define TLB_PROFILE_SCOPE(name) ((void)0)
+
+#endif
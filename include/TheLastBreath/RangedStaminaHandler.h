@@ -37,6 +37,8 @@ namespace TheLastBreath {
 
         std::unordered_map<RE::FormID, ActorState> actorStates;
         mutable std::mutex statesMutex; 
+
+        float GetRangedHoldCostPerSecond(RE::Actor* actor);
     };
 
 }
\ No newline at end of file
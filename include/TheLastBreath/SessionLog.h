@@ -0,0 +1,107 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <type_traits>
+
+// Binary session log format shared by the in-game recorder and the offline replay.
+// Deliberately free of game types so the replay side builds without CommonLibSSE.
+//
+// File layout (little endian):
+//   FileHeader
+//   config snapshot, FileHeader::configSize bytes of INI text
+//   Record, Record, ... until end of file
+namespace TheLastBreath::SessionLog {
+
+    inline constexpr std::uint32_t kMagic = 0x52424C54;  // "TLBR"
+    inline constexpr std::uint16_t kVersion = 2;  // 2: hits carry the window they were checked against
+
+    enum class RecordType : std::uint8_t {
+        BlockPress,     // value0 = animation delay, value1 = window length at press time
+        BlockRelease,
+        AnimEvent,      // tag = AnimEventType the handler matched
+        Hit,            // other = aggressor, value0 = damage taken, value1 = window the hit was checked against
+                        // (version 2+), flags = HitFlag, tag = BlockType seen live
+        CombatState,    // tag = new combat state (0 = none, 1 = combat, 2 = searching)
+
+        kCount
+    };
+
+    enum HitFlag : std::uint8_t {
+        kHitBlocked = 1 << 0,
+        kHitProjectile = 1 << 1,
+    };
+
+    // Same values as TheLastBreath::BlockType
+    enum class RecordedBlock : std::uint16_t {
+        None,
+        Timed,
+        Regular
+    };
+
+#pragma pack(push, 1)
+    struct FileHeader {
+        std::uint32_t magic = kMagic;
+        std::uint16_t version = kVersion;
+        std::uint16_t recordSize = 0;
+        std::uint32_t configSize = 0;
+        std::uint32_t reserved = 0;
+    };
+
+    // Every record has the same size so the log can be streamed and seeked without an index
+    struct Record {
+        std::uint64_t timeMicros = 0;   // Since the recording started
+        std::uint32_t actor = 0;        // FormID the event belongs to
+        std::uint32_t other = 0;        // Second FormID (aggressor), if any
+        float value0 = 0.0f;
+        float value1 = 0.0f;
+        RecordType type = RecordType::BlockPress;
+        std::uint8_t flags = 0;
+        std::uint16_t tag = 0;
+        std::uint32_t reserved = 0;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(FileHeader) == 16);
+    static_assert(sizeof(Record) == 32);
+    static_assert(std::is_trivially_copyable_v<Record>);
+
+    inline constexpr std::array<const char*, static_cast<std::size_t>(RecordType::kCount)> kRecordTypeNames = {
+        "block_press", "block_release", "anim_event", "hit", "combat_state"
+    };
+
+    // Streaming reader - holds one record at a time, so arbitrarily long sessions replay in constant memory
+    class Reader {
+    public:
+        explicit Reader(std::istream& a_stream) : stream(a_stream) {}
+
+        // Reads and checks the header and config snapshot. Returns false for foreign or newer files.
+        bool Open() {
+            if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+            if (header.magic != kMagic || header.version > kVersion || header.recordSize < sizeof(Record)) return false;
+
+            config.resize(header.configSize);
+            return header.configSize == 0 || static_cast<bool>(stream.read(config.data(), header.configSize));
+        }
+
+        bool Next(Record& record) {
+            if (!stream.read(reinterpret_cast<char*>(&record), sizeof(Record))) return false;
+
+            // Newer minor revisions may append fields to a record - skip them
+            if (header.recordSize > sizeof(Record)) {
+                stream.ignore(header.recordSize - sizeof(Record));
+            }
+            return true;
+        }
+
+        const FileHeader& GetHeader() const { return header; }
+        const std::string& GetConfigSnapshot() const { return config; }
+
+    private:
+        std::istream& stream;
+        FileHeader header;
+        std::string config;
+    };
+
+}
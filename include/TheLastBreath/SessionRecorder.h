@@ -0,0 +1,53 @@
+#pragma once
+#include "TheLastBreath/SessionLog.h"
+#include "TheLastBreath/TimedBlockHandler.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    // Records everything the plugin reacts to into a SessionLog file next to the log,
+    // so a play session can be replayed offline (see SessionReplay)
+    class SessionRecorder {
+    public:
+        static SessionRecorder* GetSingleton() {
+            static SessionRecorder singleton;
+            return &singleton;
+        }
+
+        void Start();  // New file per loaded save, only when [Debug] bRecordSessions is set
+        void Stop();
+        void Tick();   // Writes the records buffered since the last tick
+
+        bool IsRecording() const { return recording.load(std::memory_order_relaxed); }
+
+        void RecordBlockPress(RE::Actor* actor, float delay, float window);
+        void RecordBlockRelease(RE::Actor* actor);
+        void RecordAnimEvent(RE::Actor* actor, std::uint16_t eventType);
+        void RecordHit(RE::Actor* victim, RE::Actor* aggressor, float damage, std::uint8_t flags, BlockType blockType, float window);
+        void RecordCombatState(RE::Actor* actor, std::uint16_t state);
+
+    private:
+        SessionRecorder() = default;
+        SessionRecorder(const SessionRecorder&) = delete;
+        SessionRecorder(SessionRecorder&&) = delete;
+
+        static constexpr std::size_t kBufferRecords = 1024;
+
+        void Append(SessionLog::Record& record);
+        void WritePending();  // Caller holds recordMutex
+
+        std::array<SessionLog::Record, kBufferRecords> pending{};
+        std::size_t pendingCount = 0;
+        std::uint64_t written = 0;
+
+        std::ofstream file;
+        std::chrono::steady_clock::time_point startTime;
+        std::uint32_t sessionNumber = 0;
+        std::atomic<bool> recording = false;
+        std::mutex recordMutex;
+    };
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "TheLastBreath/BlockStateMachine.h"
+#include "TheLastBreath/SessionLog.h"
+#include <unordered_map>
+
+namespace TheLastBreath {
+
+    struct ReplayResult {
+        std::uint64_t records = 0;
+        std::uint64_t presses = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t timedBlocks = 0;
+        std::uint64_t regularBlocks = 0;
+        std::uint64_t unblockedHits = 0;
+        std::uint64_t mismatches = 0;       // Hits the replay classified differently than the live session
+        std::uint64_t firstMismatchMicros = 0;
+        std::uint64_t durationMicros = 0;   // Virtual time covered by the log
+    };
+
+    // Replays recorded block edges and hits on the log's virtual clock. The live handlers
+    // need game objects, so this does not run them: it repeats the BlockStateMachine calls
+    // TimedBlockHandler makes (Next, Advance, Classify) with the delay and window the live
+    // hit was checked against. Needs no game types, so recorded sessions can be replayed
+    // (and timed) on any machine.
+    class SessionReplay {
+    public:
+        // Version of the log being replayed - version 1 hits carry no window
+        explicit SessionReplay(std::uint16_t a_version = SessionLog::kVersion) :
+            version(a_version) {}
+
+        void Feed(const SessionLog::Record& record);
+        const ReplayResult& GetResult() const { return result; }
+
+    private:
+        struct ActorState {
+            BlockPhase phase = BlockPhase::Idle;
+            std::uint64_t pressMicros = 0;
+            float delay = 0.0f;
+            float window = 0.0f;   // At press time, only used for version 1 logs
+        };
+
+        SessionLog::RecordedBlock Classify(ActorState& state, std::uint64_t nowMicros, bool blocked, float hitWindow);
+
+        std::uint16_t version;
+        std::unordered_map<std::uint32_t, ActorState> actors;
+        ReplayResult result;
+    };
+
+}
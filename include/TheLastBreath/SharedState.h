@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Layout of the live state block the plugin publishes in shared memory for overlays and tools.
+// Free of game types so external readers can include it as is (see tools/StateReader.cpp).
+//
+// The block is updated in place under a sequence counter: the writer makes `sequence` odd
+// while it writes and even again when done. A reader copies the block and keeps the copy
+// only if the counter was even and unchanged around the copy - no locks, no syscalls.
+namespace TheLastBreath::SharedState {
+
+    inline constexpr std::uint32_t kMagic = 0x53424C54;  // "TLBS"
+    inline constexpr std::uint16_t kVersion = 1;
+    inline constexpr std::size_t kMaxActors = 32;
+
+    // Windows named mapping the plugin creates (Local\ = per session)
+    inline constexpr const wchar_t* kMappingName = L"Local\\TheLastBreath_State";
+
+    enum class DrainSource : std::uint8_t {
+        BlockHold,
+        BowHold,
+
+        kCount
+    };
+
+#pragma pack(push, 8)
+    struct ActorEntry {
+        std::uint32_t formID = 0;
+        std::uint8_t blockPhase = 0;    // TheLastBreath::BlockPhase (Idle, Delay, Window, Consumed, Held)
+        std::uint8_t parryCount = 0;    // Consecutive parries in the current sequence
+        std::uint8_t exhausted = 0;
+        std::uint8_t reserved = 0;
+        float sincePress = 0.0f;        // Seconds since the block button went down
+        float window = 0.0f;            // Length of the window the next timed block gets
+        std::array<float, static_cast<std::size_t>(DrainSource::kCount)> drainPerSecond{};
+    };
+
+    struct Payload {
+        std::uint64_t publishCount = 0;
+        std::uint64_t timeMicros = 0;   // Since the plugin started publishing
+        std::uint32_t actorCount = 0;
+        std::uint32_t reserved = 0;
+        std::array<ActorEntry, kMaxActors> actors{};
+    };
+
+    struct Block {
+        std::uint32_t magic = kMagic;
+        std::uint16_t version = kVersion;
+        std::uint16_t reserved = 0;
+        std::uint32_t size = sizeof(Block);
+        std::atomic<std::uint32_t> sequence = 0;
+        Payload payload;
+    };
+#pragma pack(pop)
+
+    static_assert(std::is_trivially_copyable_v<Payload>);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+    static_assert(sizeof(ActorEntry) == 24);
+
+    inline void Write(Block& block, const Payload& payload) {
+        auto sequence = block.sequence.load(std::memory_order_relaxed);
+        block.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::memcpy(&block.payload, &payload, sizeof(Payload));
+
+        block.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Returns false if the block is foreign, from a newer layout, or was being written during the copy
+    inline bool TryRead(const Block& block, Payload& out) {
+        if (block.magic != kMagic || block.version != kVersion) return false;
+
+        auto before = block.sequence.load(std::memory_order_acquire);
+        if (before & 1) return false;
+
+        std::memcpy(&out, &block.payload, sizeof(Payload));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return block.sequence.load(std::memory_order_relaxed) == before;
+    }
+
+}
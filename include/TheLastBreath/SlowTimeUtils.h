@@ -2,34 +2,87 @@
 #include "TheLastBreath/Offsets.h"
 #include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 namespace TheLastBreath {
 
     namespace SlowTimeUtils {
 
+        // One long-lived thread restores normal time speed, instead of spawning a thread per slow time.
+        // A new slow time while one is active moves the reset deadline rather than racing it.
+        class SlowTimeResetter {
+        public:
+            static SlowTimeResetter* GetSingleton() {
+                static SlowTimeResetter singleton;
+                return &singleton;
+            }
+
+            void Schedule(std::chrono::steady_clock::time_point a_deadline, bool a_useSmoothing) {
+                {
+                    std::lock_guard<std::mutex> lock(resetMutex);
+                    deadline = a_deadline;
+                    useSmoothing = a_useSmoothing;
+                    pending = true;
+
+                    if (!started) {
+                        started = true;
+                        std::thread(&SlowTimeResetter::Run, this).detach();
+                    }
+                }
+                resetCondition.notify_one();
+            }
+
+        private:
+            SlowTimeResetter() = default;
+            SlowTimeResetter(const SlowTimeResetter&) = delete;
+            SlowTimeResetter(SlowTimeResetter&&) = delete;
+
+            void Run() {
+                std::unique_lock<std::mutex> lock(resetMutex);
+                while (true) {
+                    resetCondition.wait(lock, [this] { return pending; });
+
+                    // Re-check after every wake - the deadline may have been pushed back
+                    while (pending && std::chrono::steady_clock::now() < deadline) {
+                        resetCondition.wait_until(lock, deadline);
+                    }
+
+                    if (pending) {
+                        pending = false;
+                        bool smoothing = useSmoothing;
+                        lock.unlock();
+                        Offsets::SGTM(1.0f, smoothing);
+                        logger::debug("Reset time to normal speed (smooth: {})", smoothing ? "yes" : "no");
+                        lock.lock();
+                    }
+                }
+            }
+
+            std::mutex resetMutex;
+            std::condition_variable resetCondition;
+            std::chrono::steady_clock::time_point deadline;
+            bool useSmoothing = true;
+            bool pending = false;
+            bool started = false;
+        };
+
         inline void ApplySlowTime(float duration, float percentage, bool useSmoothing = true) {
             if (duration <= 0.0f || percentage <= 0.0f || percentage >= 1.0f) {
                 return;
             }
 
-            int durationMilliseconds = static_cast<int>(duration * 1000);
-
             // Apply slow time with smooth transition
             Offsets::SGTM(percentage, useSmoothing);
             logger::debug("Applied slow time: {:.0f}% speed for {:.1f}s (smooth: {})",
                 percentage * 100.0f, duration, useSmoothing ? "yes" : "no");
 
             // Reset time after duration
-            auto resetSlowTime = [useSmoothing](int durationMs) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
-                Offsets::SGTM(1.0f, useSmoothing);
-                logger::debug("Reset time to normal speed (smooth: {})", useSmoothing ? "yes" : "no");
-                };
-
-            std::jthread resetThread(resetSlowTime, durationMilliseconds);
-            resetThread.detach();
+            auto deadline = std::chrono::steady_clock::now() +
+                std::chrono::milliseconds(static_cast<int>(duration * 1000));
+            SlowTimeResetter::GetSingleton()->Schedule(deadline, useSmoothing);
         }
 
-    } 
+    }
 
-} 
\ No newline at end of file
+}
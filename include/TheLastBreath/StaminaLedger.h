@@ -0,0 +1,77 @@
+#pragma once
+#include <array>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    // Every stamina change we make, tagged by what caused it
+    enum class LedgerSource : std::uint8_t {
+        Jump,
+        RapidCombo,
+        BowRelease,
+        BowHold,
+        BlockHold,
+        HitLoss,
+        TimedBlockGain,
+
+        kCount
+    };
+
+    // Collects signed stamina deltas from every handler and thread, nets them per actor,
+    // and applies one RestoreActorValue per actor per frame from an SKSE task, so actor
+    // values are only ever written on the main thread. Keeps running per-source totals.
+    // Deltas are netted into two fixed batches (one filling, one being applied) and the
+    // task is a persistent delegate, so posting never allocates up to kMaxPending actors a frame.
+    class StaminaLedger {
+    public:
+        static StaminaLedger* GetSingleton() {
+            static StaminaLedger singleton;
+            return &singleton;
+        }
+
+        // Negative = stamina spent, positive = stamina given back
+        void Post(RE::Actor* actor, LedgerSource source, float delta);
+
+        // Log the per-source totals since the last load
+        void LogTotals();
+        void ClearAll();
+
+    private:
+        StaminaLedger() = default;
+        StaminaLedger(const StaminaLedger&) = delete;
+        StaminaLedger(StaminaLedger&&) = delete;
+
+        static constexpr std::size_t kMaxPending = 128;
+
+        struct Pending {
+            RE::FormID formID = 0;
+            RE::ObjectRefHandle handle;
+            float net = 0.0f;
+        };
+
+        struct Batch {
+            std::array<Pending, kMaxPending> entries{};
+            std::size_t count = 0;
+        };
+
+        // Queued at most once at a time, and never deleted by the task queue
+        class ApplyTask : public SKSE::detail::TaskDelegate {
+        public:
+            void Run() override { StaminaLedger::GetSingleton()->Apply(); }
+            void Dispose() override {}
+        };
+
+        // Main thread, once per frame while anything is pending
+        void Apply();
+
+        static void ApplyDelta(RE::Actor* actor, float net);
+
+        std::mutex mutex;
+        std::array<Batch, 2> batches{};
+        std::size_t posting = 0;  // Batch Post() fills; Apply() takes it and switches to the other
+        bool taskQueued = false;
+        ApplyTask applyTask;
+        std::array<double, static_cast<std::size_t>(LedgerSource::kCount)> totals{};
+    };
+
+}
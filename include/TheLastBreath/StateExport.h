@@ -0,0 +1,51 @@
+#pragma once
+#include "TheLastBreath/BlockStateMachine.h"
+#include "TheLastBreath/SharedState.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    // Publishes the handlers' live per-actor state to a named shared memory block (SharedState.h).
+    // Handlers report into a staging copy during the update pass; Publish() copies it into the
+    // mapping once per pass, so readers see one consistent snapshot per tick.
+    class StateExport {
+    public:
+        static StateExport* GetSingleton() {
+            static StateExport singleton;
+            return &singleton;
+        }
+
+        bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+        void Open();   // Creates the mapping when [Debug] bExportSharedState is set, kept until exit
+
+        // Update pass: per-pass values are cleared by BeginPass and refilled by the handlers
+        void BeginPass();
+        void Publish();
+
+        void SetBlockState(RE::FormID formID, BlockPhase phase, float sincePress, float window);
+        void SetDrain(RE::FormID formID, SharedState::DrainSource source, float perSecond);
+        void SetExhausted(RE::FormID formID, bool exhausted);
+
+        // Kept across passes until the sequence ends
+        void SetParryCount(RE::FormID formID, std::uint32_t count);
+
+    private:
+        StateExport() = default;
+        StateExport(const StateExport&) = delete;
+        StateExport(StateExport&&) = delete;
+
+        // Caller holds stagingMutex. nullptr when every slot is taken.
+        SharedState::ActorEntry* FindOrAdd(RE::FormID formID);
+
+        SharedState::Payload staging;
+        SharedState::Block* block = nullptr;
+        void* mapping = nullptr;
+        std::atomic<bool> enabled = false;
+        std::chrono::steady_clock::time_point startTime;
+        std::mutex stagingMutex;
+    };
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+
+namespace TheLastBreath {
+
+    // Where the player's stamina went
+    enum class StaminaSource : std::uint8_t {
+        Jump,
+        LightAttack,
+        BowHold,
+        BowRelease,
+        BlockHold,
+        HitLoss,
+
+        kCount
+    };
+
+    // Folds the player's combat activity into per-encounter aggregates as it happens and
+    // appends one fixed-width row per encounter to TheLastBreath_Encounters.txt.
+    // An encounter runs from the player entering combat until they leave it.
+    class Telemetry {
+    public:
+        static Telemetry* GetSingleton() {
+            static Telemetry singleton;
+            return &singleton;
+        }
+
+        void RecordParry(RE::Actor* actor, std::uint32_t parryLevel);
+        void RecordTimedBlockOffset(RE::Actor* actor, float timeInWindow, float windowDuration);
+        void RecordRegularBlock(RE::Actor* actor);
+        void RecordStamina(RE::Actor* actor, StaminaSource source, float amount);
+        void RecordExhaustion(RE::Actor* actor, bool exhausted);
+
+        // The engine asks for an attack's cost more than once per swing, so light attack stamina is
+        // counted when the swing animation starts, using the last light attack cost handed out.
+        // Power attacks and bashes set 0 so their swings don't count as light attacks.
+        void SetPendingAttackCost(RE::Actor* actor, float lightCost);
+        void RecordAttackSwing(RE::Actor* actor);
+
+        void Tick();   // Opens/closes encounters from the player's combat state, writes due rows
+        void Flush();  // Writes every finished row now
+
+    private:
+        Telemetry();
+        Telemetry(const Telemetry&) = delete;
+        Telemetry(Telemetry&&) = delete;
+
+        static constexpr std::size_t kParryColumns = 6;  // Level 6 and above share the last column
+        static constexpr std::size_t kBatchSize = 16;
+
+        using Clock = std::chrono::steady_clock;
+
+        struct Encounter {
+            std::uint32_t number = 0;
+            Clock::time_point start;
+            Clock::time_point exhaustedSince;
+            float exhaustedSeconds = 0.0f;
+            bool exhausted = false;
+
+            std::array<std::uint32_t, kParryColumns> parries{};
+            std::uint32_t timedBlocks = 0;
+            std::uint32_t regularBlocks = 0;
+            double windowOffsetSum = 0.0;  // Fraction of the window elapsed at each timed block
+            std::array<float, static_cast<std::size_t>(StaminaSource::kCount)> stamina{};
+        };
+
+        struct Row {
+            Encounter encounter;
+            float durationSeconds = 0.0f;
+        };
+
+        bool IsTracked(RE::Actor* actor) const;
+        void BeginEncounter(Clock::time_point now);
+        void EndEncounter(Clock::time_point now);
+        void WriteRows();  // Caller holds telemetryMutex
+
+        Encounter current;
+        float pendingAttackCost = 0.0f;
+        bool inEncounter = false;
+        std::uint32_t encounterCount = 0;
+
+        std::array<Row, kBatchSize> rows{};
+        std::size_t rowCount = 0;
+        Clock::time_point lastWrite;
+
+        std::filesystem::path encountersPath;
+        const Clock::time_point startTime;
+        mutable std::mutex telemetryMutex;
+    };
+
+}
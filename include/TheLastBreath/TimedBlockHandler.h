@@ -1,15 +1,10 @@
 #pragma once
+#include "TheLastBreath/BlockStateMachine.h"
 #include <chrono>
 #include <mutex>
 
 namespace TheLastBreath {
 
-    enum class BlockType {
-        None,
-        Timed,
-        Regular
-    };
-
     class TimedBlockHandler {
     public:
         static TimedBlockHandler* GetSingleton() {
@@ -23,7 +18,8 @@ namespace TheLastBreath {
         // Check if timed block window is currently active for this actor
         bool IsTimedBlockWindowActive(RE::Actor* actor) const;
 
-        BlockType CheckBlockType(RE::Actor* actor);
+        // windowUsed, if given, receives the window length the hit was checked against (0 when not blocking)
+        BlockType CheckBlockType(RE::Actor* actor, float* windowUsed = nullptr);
         void ConsumeTimedBlock(RE::Actor* actor);
         void Update();  // Check button state each frame
         void ClearActor(RE::Actor* actor);
@@ -34,13 +30,16 @@ namespace TheLastBreath {
         TimedBlockHandler(TimedBlockHandler&&) = delete;
 
         struct BlockState {
-            bool isButtonPressed = false;
-            bool windowActive = false;
-            bool windowConsumed = false;
             std::chrono::steady_clock::time_point buttonPressTime;
-            std::chrono::steady_clock::time_point windowStartTime;
+            BlockPhase phase = BlockPhase::Idle;
         };
 
+        // Parry level the actor's next timed block would reach (1-based ladder level)
+        static uint32_t GetNextParryLevel(RE::Actor* actor);
+
+        // Window length for a parry level, scaled by the actor's profile
+        static float GetWindowDuration(RE::Actor* actor, uint32_t nextParryLevel);
+
         std::unordered_map<RE::FormID, BlockState> actorStates;
         mutable std::mutex statesMutex;
     };
@@ -0,0 +1,76 @@
+#pragma once
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace TheLastBreath {
+
+    enum WeaponStatFlag : std::uint8_t {
+        kStatShield = 1 << 0,
+        kStatRanged = 1 << 1       // Bow or crossbow
+    };
+
+    struct WeaponStats {
+        float weight = 0.0f;
+        std::uint8_t type = 0;     // RE::WEAPON_TYPE, 0 for shields
+        std::uint8_t flags = 0;    // WeaponStatFlag
+
+        bool IsShield() const { return flags & kStatShield; }
+        bool IsRanged() const { return flags & kStatRanged; }
+    };
+
+    // Weight, type, class flags and keywords of every weapon and shield, read from the forms
+    // once at kDataLoaded into a table that is never written after that, so cost formulas and
+    // profile resolution look items up without locks or extra form reads. Keywords of all items
+    // share one flat array. Items created at runtime (0xFF, e.g. player enchanted) aren't in the
+    // load-time table; they are read from the form on first use and kept until the next load.
+    class WeaponStatsCache {
+    public:
+        static WeaponStatsCache* GetSingleton() {
+            static WeaponStatsCache singleton;
+            return &singleton;
+        }
+
+        void Build();
+        void ClearRuntime();  // Runtime FormIDs are reused by the next save
+
+        // nullopt for anything that isn't a weapon or shield
+        std::optional<WeaponStats> Find(RE::FormID formID);
+
+        bool HasKeyword(RE::FormID formID, RE::FormID keyword);
+
+        // Shield in the left hand, else the right hand weapon
+        std::optional<WeaponStats> GetBlockingItem(RE::Actor* actor);
+
+    private:
+        WeaponStatsCache() = default;
+        WeaponStatsCache(const WeaponStatsCache&) = delete;
+        WeaponStatsCache(WeaponStatsCache&&) = delete;
+
+        struct Item {
+            WeaponStats stats;
+            std::uint32_t keywordBegin = 0;   // Range in `keywords` (or the runtime item's own list)
+            std::uint32_t keywordCount = 0;
+        };
+
+        struct RuntimeItem {
+            std::optional<WeaponStats> stats;  // nullopt = not a weapon or shield, don't read it again
+            std::vector<RE::FormID> keywords;
+        };
+
+        static bool IsRuntime(RE::FormID formID) { return (formID >> 24) == 0xFF; }
+
+        // Reads a weapon or shield form, nullopt for anything else
+        static std::optional<WeaponStats> Read(RE::TESForm* form, std::vector<RE::FormID>& keywordsOut);
+
+        const RuntimeItem& GetRuntime(RE::FormID formID);  // Caller holds runtimeMutex
+
+        std::unordered_map<RE::FormID, Item> items;
+        std::vector<RE::FormID> keywords;
+
+        std::mutex runtimeMutex;
+        std::unordered_map<RE::FormID, RuntimeItem> runtimeItems;
+    };
+
+}
@@ -0,0 +1,69 @@
+#include "TheLastBreath/ActorValueCache.h"
+
+namespace TheLastBreath {
+
+    namespace {
+
+        float ReadValue(RE::Actor* actor, CachedValue value) {
+            auto avOwner = actor->AsActorValueOwner();
+            switch (value) {
+            case CachedValue::Stamina:
+                return avOwner->GetActorValue(RE::ActorValue::kStamina);
+            case CachedValue::PermanentStamina:
+                return avOwner->GetPermanentActorValue(RE::ActorValue::kStamina);
+            case CachedValue::Block:
+                return avOwner->GetActorValue(RE::ActorValue::kBlock);
+            case CachedValue::SpeedMult:
+                return avOwner->GetActorValue(RE::ActorValue::kSpeedMult);
+            case CachedValue::AttackDamageMult:
+                return avOwner->GetActorValue(RE::ActorValue::kAttackDamageMult);
+            default:
+                return 0.0f;
+            }
+        }
+
+    }
+
+    void ActorValueCache::BeginPass() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++currentPass;
+    }
+
+    float ActorValueCache::Get(RE::Actor* actor, CachedValue value) {
+        if (!actor) return 0.0f;
+
+        auto bit = static_cast<std::uint8_t>(1u << static_cast<std::uint8_t>(value));
+        auto index = static_cast<std::size_t>(value);
+
+        auto formID = actor->GetFormID();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& snapshot = snapshots[SlotOf(formID)];
+
+        if (snapshot.formID != formID || snapshot.pass != currentPass) {
+            snapshot.formID = formID;
+            snapshot.pass = currentPass;
+            snapshot.validMask = 0;
+        }
+
+        if (!(snapshot.validMask & bit)) {
+            snapshot.values[index] = ReadValue(actor, value);
+            snapshot.validMask |= bit;
+        }
+
+        return snapshot.values[index];
+    }
+
+    void ActorValueCache::MarkDirty(RE::FormID formID) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto& snapshot = snapshots[SlotOf(formID)]; snapshot.formID == formID) {
+            snapshot.validMask = 0;
+        }
+    }
+
+    void ActorValueCache::ClearAll() {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshots.fill({});
+    }
+
+}
@@ -3,6 +3,11 @@
 #include "TheLastBreath/TimedBlockHandler.h"
 #include "TheLastBreath/Config.h"
 #include "TheLastBreath/EldenCounterCompat.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/SessionRecorder.h"
+#include "TheLastBreath/StaminaLedger.h"
+#include "TheLastBreath/Telemetry.h"
 #include <unordered_map>
 
 
@@ -15,6 +20,7 @@ namespace TheLastBreath {
         BowRelease,
         HKS_TriggerA,
         JumpUp,
+        WeaponSwing,
     };
 
     // OPTIMIZATION: Hash map for O(1) event lookup instead of O(n) string comparisons
@@ -24,6 +30,8 @@ namespace TheLastBreath {
         {"bowRelease", AnimEventType::BowRelease},
         {"HKS_TriggerA", AnimEventType::HKS_TriggerA},
         {"JumpUp", AnimEventType::JumpUp},
+        {"weaponSwing", AnimEventType::WeaponSwing},
+        {"weaponLeftSwing", AnimEventType::WeaponSwing},
     };
 
     AnimationEventHandler* AnimationEventHandler::GetSingleton() {
@@ -35,6 +43,7 @@ namespace TheLastBreath {
         const RE::BSAnimationGraphEvent* a_event,
         RE::BSTEventSource<RE::BSAnimationGraphEvent>* a_eventSource)
     {
+        TLB_PROFILE_SCOPE("AnimationEventHandler::ProcessEvent");
 
         if (!a_event || !a_event->holder) {
             return RE::BSEventNotifyControl::kContinue;
@@ -73,6 +82,8 @@ namespace TheLastBreath {
 
         logger::trace("Animation event: '{}' from {}", eventName, isPlayer ? "Player" : actor->GetName());
 
+        SessionRecorder::GetSingleton()->RecordAnimEvent(actor, static_cast<std::uint16_t>(eventIt->second));
+
         // Cache singleton pointers (minor optimization)
         auto rangedHandler = RangedStaminaHandler::GetSingleton();
         auto config = Config::GetSingleton();
@@ -87,13 +98,7 @@ namespace TheLastBreath {
         case AnimEventType::BowRelease:
         {
             // only process if we're actually tracking OR if bow is equipped
-            bool hasBowEquipped = false;
-            if (const auto obj = actor->GetEquippedObject(false)) {
-                if (const auto weap = obj->As<RE::TESObjectWEAP>()) {
-                    const auto wt = weap->GetWeaponType();
-                    hasBowEquipped = (wt == RE::WEAPON_TYPE::kBow || wt == RE::WEAPON_TYPE::kCrossbow);
-                }
-            }
+            bool hasBowEquipped = EquipmentSnapshot::GetSingleton()->Get(actor).HasRanged();
 
             if (!hasBowEquipped) {
                 return RE::BSEventNotifyControl::kContinue;
@@ -109,17 +114,11 @@ namespace TheLastBreath {
         {
             logger::debug("HKS_TriggerA event (Rapid Combo)");
 
-            if (!config->enableStaminaManagement || !config->enableRangedStaminaCost) {
+            if (!config->derived.rangedCost) {
                 return RE::BSEventNotifyControl::kContinue;
             }
 
-            bool isRanged = false;
-            if (const auto obj = actor->GetEquippedObject(false)) {
-                if (const auto weap = obj->As<RE::TESObjectWEAP>()) {
-                    const auto wt = weap->GetWeaponType();
-                    isRanged = (wt == RE::WEAPON_TYPE::kBow || wt == RE::WEAPON_TYPE::kCrossbow);
-                }
-            }
+            bool isRanged = EquipmentSnapshot::GetSingleton()->Get(actor).HasRanged();
 
             if (!isRanged) {
                 return RE::BSEventNotifyControl::kContinue;
@@ -128,10 +127,7 @@ namespace TheLastBreath {
             if (config->enableRapidComboStaminaCost) {
                 const float cost = config->rapidComboStaminaCost;
                 if (cost > 0.0f) {
-                    actor->AsActorValueOwner()->RestoreActorValue(
-                        RE::ACTOR_VALUE_MODIFIER::kDamage,
-                        RE::ActorValue::kStamina,
-                        -cost);
+                    StaminaLedger::GetSingleton()->Post(actor, LedgerSource::RapidCombo, -cost);
                     logger::debug("Rapid Combo stamina cost: {}", cost);
                 }
             }
@@ -139,18 +135,21 @@ namespace TheLastBreath {
         }
 
         case AnimEventType::JumpUp:
-            if (config->enableStaminaManagement && config->enableJumpStaminaCost) {
+            if (config->derived.jumpCost) {
                 const float cost = config->jumpStaminaCost;
                 if (cost > 0.0f) {
-                    actor->AsActorValueOwner()->RestoreActorValue(
-                        RE::ACTOR_VALUE_MODIFIER::kDamage,
-                        RE::ActorValue::kStamina,
-                        -cost);
+                    StaminaLedger::GetSingleton()->Post(actor, LedgerSource::Jump, -cost);
                     logger::debug("Jump stamina cost: {}", cost);
+                    Telemetry::GetSingleton()->RecordStamina(actor, StaminaSource::Jump, cost);
                 }
             }
             break;
 
+        case AnimEventType::WeaponSwing:
+            // The swing the light attack cost was charged for
+            Telemetry::GetSingleton()->RecordAttackSwing(actor);
+            break;
+
         default:
             break;
         }
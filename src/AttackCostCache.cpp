@@ -0,0 +1,84 @@
+#include "TheLastBreath/AttackCostCache.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+
+namespace TheLastBreath {
+
+    RE::BSEventNotifyControl AttackCostCache::ProcessEvent(
+        const RE::MenuOpenCloseEvent* a_event,
+        RE::BSTEventSource<RE::MenuOpenCloseEvent>* a_eventSource)
+    {
+        if (!a_event || a_event->opening) {
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        if (a_event->menuName == RE::StatsMenu::MENU_NAME || a_event->menuName == RE::LevelUpMenu::MENU_NAME) {
+            perkEpoch.fetch_add(1, std::memory_order_relaxed);
+            logger::debug("Perks may have changed - cached attack costs are stale");
+        }
+
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    RE::BSEventNotifyControl AttackCostCache::ProcessEvent(
+        const RE::TESActiveEffectApplyRemoveEvent* a_event,
+        RE::BSTEventSource<RE::TESActiveEffectApplyRemoveEvent>* a_eventSource)
+    {
+        // Ability and potion effects can carry perks or the actor values perk entries test
+        if (a_event && a_event->target) {
+            InvalidateActor(a_event->target->GetFormID());
+        }
+
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+    RE::FormID AttackCostCache::GetAttackWeapon(RE::Actor* actor, const RE::BGSAttackData* attackData) {
+        auto equipment = EquipmentSnapshot::GetSingleton()->Get(actor);
+        return attackData->IsLeftAttack() ? equipment.left : equipment.right;
+    }
+
+    std::optional<float> AttackCostCache::Find(RE::Actor* actor, const RE::BGSAttackData* attackData) {
+        if (!actor || !attackData) return std::nullopt;
+
+        auto weapon = GetAttackWeapon(actor, attackData);
+        auto epoch = perkEpoch.load(std::memory_order_relaxed);
+        auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = actors.find(actor->GetFormID());
+        if (it == actors.end()) return std::nullopt;
+
+        for (const auto& entry : it->second.entries) {
+            if (entry.attackData == attackData && entry.weapon == weapon && entry.epoch == epoch && now < entry.expiresAt) {
+                return entry.cost;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void AttackCostCache::Store(RE::Actor* actor, const RE::BGSAttackData* attackData, float cost) {
+        if (!actor || !attackData) return;
+
+        Entry entry{ GetAttackWeapon(actor, attackData), attackData, perkEpoch.load(std::memory_order_relaxed), cost,
+            std::chrono::steady_clock::now() + kEntryLifetime };
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& slots = actors[actor->GetFormID()];
+        slots.entries[slots.next] = entry;
+        slots.next = (slots.next + 1) % kEntriesPerActor;
+    }
+
+    void AttackCostCache::InvalidateActor(RE::FormID formID) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Keep the node - re-equipping shouldn't allocate
+        if (auto it = actors.find(formID); it != actors.end()) {
+            it->second = {};
+        }
+    }
+
+    void AttackCostCache::ClearAll() {
+        std::lock_guard<std::mutex> lock(mutex);
+        actors.clear();
+    }
+
+}
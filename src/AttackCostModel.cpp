@@ -0,0 +1,118 @@
+#include "TheLastBreath/AttackCostModel.h"
+#include "TheLastBreath/Config.h"
+#include <iomanip>
+
+namespace TheLastBreath {
+
+    void AttackCostModel::Initialize() {
+        available.store(false);
+        validated.store(false);
+
+        if (!Config::GetSingleton()->closedFormAttackCost) {
+            logger::info("Closed-form attack cost disabled - light attacks ask the engine for the power attack cost");
+            return;
+        }
+
+        auto settings = RE::GameSettingCollection::GetSingleton();
+        if (!settings) {
+            logger::warn("Game settings unavailable - closed-form attack cost disabled");
+            return;
+        }
+
+        weaponBase = settings->GetSetting("fStaminaAttackWeaponBase");
+        weaponMult = settings->GetSetting("fStaminaAttackWeaponMult");
+        powerPenalty = settings->GetSetting("fPowerAttackStaminaPenalty");
+
+        if (!weaponBase || !weaponMult || !powerPenalty) {
+            logger::warn("Attack stamina game settings missing - closed-form attack cost disabled");
+            return;
+        }
+
+        available.store(true);
+        logger::info("Closed-form attack cost ready, used after the first power attack confirms it "
+            "(base {:.2f}, weight mult {:.2f}, power penalty {:.2f})",
+            weaponBase->GetFloat(), weaponMult->GetFloat(), powerPenalty->GetFloat());
+    }
+
+    AttackCostModel::Costing AttackCostModel::Compute(RE::Actor* actor, const RE::BGSAttackData* attackData) const {
+        auto equipped = actor->GetEquippedObject(attackData->IsLeftAttack());
+        auto weapon = equipped ? equipped->As<RE::TESObjectWEAP>() : nullptr;
+
+        Costing costing;
+        costing.inputs.weaponBase = weaponBase->GetFloat();
+        costing.inputs.weaponMult = weaponMult->GetFloat();
+        costing.inputs.powerPenalty = powerPenalty->GetFloat();
+        costing.inputs.weight = weapon ? weapon->weight : 0.0f;  // Unarmed pays the base cost only
+        costing.inputs.staminaMult = attackData->data.staminaMult;
+        costing.cost = AttackCostFormula::PowerAttackCost(costing.inputs);
+
+        RE::BGSEntryPoint::HandleEntryPoint(RE::BGSEntryPoint::ENTRY_POINT::kModPowerAttackStamina,
+            actor, weapon, &costing.cost);
+
+        return costing;
+    }
+
+    std::optional<float> AttackCostModel::PowerAttackCost(RE::Actor* actor, const RE::BGSAttackData* attackData) {
+        if (!actor || !attackData || !IsAvailable() || !IsValidated()) {
+            return std::nullopt;
+        }
+        return Compute(actor, attackData).cost;
+    }
+
+    void AttackCostModel::Validate(RE::Actor* actor, const RE::BGSAttackData* attackData, float engineCost) {
+        if (!actor || !attackData || !IsAvailable()) return;
+
+        // A power bash is kBash | kPower, but the engine costs bashes with their own settings
+        if (attackData->data.flags.none(RE::AttackData::AttackFlag::kPowerAttack) ||
+            attackData->data.flags.any(RE::AttackData::AttackFlag::kBashAttack)) {
+            return;
+        }
+
+        auto costing = Compute(actor, attackData);
+        if (Config::GetSingleton()->recordAttackCosts) {
+            RecordRow(costing, engineCost);
+        }
+
+        if (AttackCostFormula::Matches(costing.cost, engineCost)) {
+            if (!validated.exchange(true)) {
+                logger::info("Closed-form attack cost matches the engine ({:.2f}) - light attacks use it from now on",
+                    engineCost);
+            }
+            return;
+        }
+
+        // Only the first mismatch is reported - after that nobody reads the model
+        if (available.exchange(false)) {
+            logger::warn("Closed-form attack cost disagrees with the engine for {} ({:.2f} vs {:.2f}) - "
+                "falling back to engine costing", actor->GetName(), costing.cost, engineCost);
+        }
+    }
+
+    void AttackCostModel::RecordRow(const Costing& costing, float engineCost) {
+        std::lock_guard<std::mutex> lock(costFileMutex);
+
+        if (!costFile.is_open()) {
+            auto directory = logger::log_directory();
+            if (!directory) return;
+
+            auto path = *directory / "TheLastBreath_AttackCosts.csv";
+            bool exists = std::filesystem::exists(path);
+            costFile.open(path, std::ios::app);
+            if (!costFile) return;
+
+            costFile << std::setprecision(9);  // Enough digits for a float to read back exactly
+            if (!exists) {
+                costFile << "weapon_base,weapon_mult,power_penalty,weight,stamina_mult,entry_point_mult,engine_cost\n";
+            }
+        }
+
+        // The perk entry point is game side - its effect travels with the row as a multiplier
+        float formula = AttackCostFormula::PowerAttackCost(costing.inputs);
+        float entryPointMult = formula != 0.0f ? costing.cost / formula : 1.0f;
+
+        costFile << costing.inputs.weaponBase << ',' << costing.inputs.weaponMult << ',' << costing.inputs.powerPenalty << ','
+            << costing.inputs.weight << ',' << costing.inputs.staminaMult << ',' << entryPointMult << ',' << engineCost << '\n';
+        costFile.flush();
+    }
+
+}
@@ -1,32 +1,45 @@
 #include "TheLastBreath/BlockEffectsHandler.h"
 #include "TheLastBreath/Config.h"
 #include "TheLastBreath/Data.h"
-#include "TheLastBreath/Offsets.h"
 #include "TheLastBreath/SlowTimeUtils.h"
 #include "TheLastBreath/EldenCounterCompat.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+#include "TheLastBreath/FrameGovernor.h"
+#include "TheLastBreath/FxAnchorPool.h"
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/ParryLadder.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/Telemetry.h"
+#include "TheLastBreath/StateExport.h"
+#include "TheLastBreath/ParryLatency.h"
+#include "TheLastBreath/Profiler.h"
 
 namespace TheLastBreath {
 
-    uint32_t BlockEffectsHandler::GetCurrentParryCount(RE::Actor* actor) const {
+    RE::FormID BlockEffectsHandler::ChainAggressor(RE::Actor* aggressor) {
+        if (Config::GetSingleton()->globalParryChain || !aggressor) return 0;
+        return aggressor->GetFormID();
+    }
+
+    uint32_t BlockEffectsHandler::GetCurrentParryCount(RE::Actor* actor) {
         if (!actor) return 0;
 
         std::lock_guard<std::mutex> lock(statesMutex);
 
-        auto it = actorStates.find(actor->GetFormID());
-        if (it == actorStates.end()) return 0;
-
-        return it->second.consecutiveCount;
+        // The window is sized before we know who swings - assume the opponent of the last parry
+        return chains.GetLastCount(actor->GetFormID(), std::chrono::steady_clock::now());
     }
 
-    void BlockEffectsHandler::PlaySlowTimeEffect(uint32_t parryLevel) {
+    void BlockEffectsHandler::PlaySlowTimeEffect(uint32_t parryLevel, float durationScale) {
         auto config = Config::GetSingleton();
+        bool isFinalLevel = ParryLadder::GetSingleton()->IsFinalLevel(parryLevel);
 
         // Check if slow time should be applied
         bool shouldApplySlowTime = false;
 
         if (config->slowTimeOnlyOnPerfectParry) {
-            // Only apply on perfect parry (level 5)
-            shouldApplySlowTime = (parryLevel == 5);
+            // Only apply on perfect parry (final ladder level)
+            shouldApplySlowTime = isFinalLevel;
         }
         else {
             // Apply on all timed blocks
@@ -38,9 +51,9 @@ namespace TheLastBreath {
         }
 
         // Apply the slow time effect
-        SlowTimeUtils::ApplySlowTime(config->slowTimeDuration, config->slowTimePercentage);
+        SlowTimeUtils::ApplySlowTime(config->slowTimeDuration * durationScale, config->slowTimePercentage);
 
-        if (parryLevel == 5) {
+        if (isFinalLevel) {
             logger::info("Applied PERFECT PARRY slow time effect");
         }
         else {
@@ -57,7 +70,7 @@ namespace TheLastBreath {
         auto eldenCounter = EldenCounterCompat::GetSingleton();
         if (!eldenCounter->IsAvailable()) return;
 
-        bool isPerfectParry = (parryLevel == 5);
+        bool isPerfectParry = ParryLadder::GetSingleton()->IsFinalLevel(parryLevel);
         eldenCounter->TriggerCounter(blocker, isPerfectParry);
     }
 
@@ -69,13 +82,9 @@ namespace TheLastBreath {
 
         std::lock_guard<std::mutex> lock(statesMutex);
 
-        // OPTIMIZATION: Use try_emplace instead of operator[]
-        auto [it, inserted] = actorStates.try_emplace(formID);
-        auto& state = it->second;
-
-        // Update last parry time
         auto now = std::chrono::steady_clock::now();
-        state.lastParryTime = now;
+        auto chainAggressor = ChainAggressor(aggressor);
+        uint32_t consecutiveCount = chains.GetCount(formID, chainAggressor, now);
 
         // Determine equipment type
         auto equipType = GetBlockEquipmentType(blocker);
@@ -84,118 +93,139 @@ namespace TheLastBreath {
             return;
         }
 
-        // Determine parry level (1-5)
-        uint32_t parryLevel = state.consecutiveCount + 1;
+        // Determine parry level (1..ladder length)
+        auto ladder = ParryLadder::GetSingleton();
+        uint32_t parryLevel = consecutiveCount + 1;
+        const auto& level = ladder->GetLevel(parryLevel);
+        bool isFinalLevel = ladder->IsFinalLevel(parryLevel);
+
+        // Check if we've reached perfect parry (final level)
+        bool isPerfectParry = (isFinalLevel && config->enablePerfectParry);
 
-        // Check if we've reached perfect parry (parry 5)
-        bool isPerfectParry = (parryLevel == 5 && config->enablePerfectParry);
+        auto metrics = Metrics::GetSingleton();
+        metrics->Increment(Counter::TimedBlocks);
+        metrics->RecordParryLevel(parryLevel);
+        if (isPerfectParry) {
+            metrics->Increment(Counter::PerfectParries);
+        }
+        Telemetry::GetSingleton()->RecordParry(blocker, parryLevel);
 
-        logger::info("=== PARRY {} {} ===",
-            isPerfectParry ? "PERFECT" : std::to_string(parryLevel),
+        logger::info("=== PARRY {}{} {} ===",
+            parryLevel,
+            isPerfectParry ? " PERFECT" : "",
             equipType == BlockEquipmentType::Shield ? "(SHIELD)" : "(WEAPON)");
 
+        // Cosmetics the frame budget can afford on this parry
+        auto governor = FrameGovernor::GetSingleton();
+        auto plan = governor->Plan();
+        auto cosmeticStart = std::chrono::steady_clock::now();
+
         // Play slow time effect
-        PlaySlowTimeEffect(parryLevel);
+        PlaySlowTimeEffect(parryLevel, plan.slowTimeScale);
+        auto cosmeticCost = std::chrono::steady_clock::now() - cosmeticStart;
 
         // Trigger Elden Counter (if enabled and available)
         auto eldenCounter = EldenCounterCompat::GetSingleton();
         eldenCounter->TriggerCounter(blocker, isPerfectParry);
 
+        cosmeticStart = std::chrono::steady_clock::now();
+
         // Play spark effect
-        if (config->enableParrySparks) {
-            PlayBlockSpark(blocker, equipType, parryLevel);
+        if (config->enableParrySparks && plan.sparks) {
+            PlayBlockSpark(blocker, equipType, parryLevel, plan.ring);
         }
 
         // Play sound
         PlayBlockSound(blocker, equipType, parryLevel);
+        ParryLatency::GetSingleton()->Checkpoint(blocker, ParryStage::EffectsIssued);
+
+        governor->RecordCosmeticCost(cosmeticCost + (std::chrono::steady_clock::now() - cosmeticStart));
 
         // Apply stagger to aggressor
         if (aggressor && aggressor->Get3D()) {
+            // Aggressor's profile decides how hard it can be staggered
+            float staggerMult = ProfileManager::GetSingleton()->GetProfile(aggressor).parryStaggerMult;
+
             if (isPerfectParry) {
-                // Perfect parry (5) - Heavy guard break stagger
-                ApplyStagger(aggressor, blocker, config->perfectParryStaggerMagnitude);
+                // Perfect parry - Heavy guard break stagger
+                float magnitude = level.staggerMagnitude * staggerMult;
+                ApplyStagger(aggressor, blocker, magnitude);
                 logger::info("Applied GUARD BREAK to {} (magnitude: {:.1f})",
-                    aggressor->GetName(), config->perfectParryStaggerMagnitude);
+                    aggressor->GetName(), magnitude);
 
                 // Reset after perfect parry
-                state.consecutiveCount = 0;
-                state.isPerfectParryActive = false;
+                consecutiveCount = 0;
             }
-            else if (config->enableParryStagger && parryLevel <= 4) {
-                // Regular parry (1-4) - Escalating light stagger
-                float magnitude = 0.0f;
-                switch (parryLevel) {
-                case 1: magnitude = config->parryStaggerMagnitude1; break;
-                case 2: magnitude = config->parryStaggerMagnitude2; break;
-                case 3: magnitude = config->parryStaggerMagnitude3; break;
-                case 4: magnitude = config->parryStaggerMagnitude4; break;
-                }
+            else if (config->enableParryStagger && !isFinalLevel) {
+                // Regular parry - Escalating light stagger
+                float magnitude = level.staggerMagnitude * staggerMult;
 
                 ApplyLightStagger(aggressor, blocker, magnitude);
 
                 // Calculate next timeout
-                float nextTimeout = config->parrySequenceTimeoutBase + static_cast<float>(parryLevel);
+                float nextTimeout = ladder->GetTimeout(config->parrySequenceTimeoutBase, parryLevel);
                 logger::debug("Applied parry {} stagger (magnitude: {:.1f}). Next timeout: {:.1f}s",
                     parryLevel, magnitude, nextTimeout);
 
                 // Increment counter for next parry
-                state.consecutiveCount++;
+                consecutiveCount++;
             }
         }
         else {
             // No aggressor - just increment or reset
             if (isPerfectParry) {
-                state.consecutiveCount = 0;
-                state.isPerfectParryActive = false;
+                consecutiveCount = 0;
             }
-            else if (parryLevel < 5) {
-                state.consecutiveCount++;
+            else if (!isFinalLevel) {
+                consecutiveCount++;
             }
         }
 
-        logger::debug("Parry sequence: {}/5", state.consecutiveCount);
+        // The chain lives for the ladder timeout of the level it reached
+        auto timeout = std::chrono::duration<float>(ladder->GetTimeout(config->parrySequenceTimeoutBase, consecutiveCount));
+        chains.Set(formID, chainAggressor, consecutiveCount, now,
+            now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout));
+
+        // Blockers, not (blocker, aggressor) pairs - one actor fighting several opponents counts once
+        metrics->SetGauge(Gauge::BlockEffectsActors, static_cast<std::int64_t>(chains.Blockers()));
+
+        logger::debug("Parry sequence: {}/{} against {:X}", consecutiveCount, ladder->GetLevelCount(), chainAggressor);
+        StateExport::GetSingleton()->SetParryCount(blocker->GetFormID(), consecutiveCount);
     }
 
-    void BlockEffectsHandler::OnTimedBlockFailed(RE::Actor* blocker) {
+    void BlockEffectsHandler::OnProjectileDeflected(RE::Actor* blocker) {
         if (!blocker) return;
 
-        std::lock_guard<std::mutex> lock(statesMutex);
+        auto equipType = GetBlockEquipmentType(blocker);
+        if (equipType == BlockEquipmentType::None) return;
 
-        auto formID = blocker->GetFormID();
-        auto it = actorStates.find(formID);
-        if (it != actorStates.end()) {
-            it->second.consecutiveCount = 0;
-            it->second.isPerfectParryActive = false;
-            logger::debug("Parry sequence RESET - failed block");
+        auto governor = FrameGovernor::GetSingleton();
+        auto plan = governor->Plan();
+        auto cosmeticStart = std::chrono::steady_clock::now();
+
+        if (Config::GetSingleton()->enableParrySparks && plan.sparks) {
+            PlayBlockSpark(blocker, equipType, 1, plan.ring);
         }
+        PlayBlockSound(blocker, equipType, 1);
+
+        governor->RecordCosmeticCost(std::chrono::steady_clock::now() - cosmeticStart);
     }
 
-    void BlockEffectsHandler::Update() {
-        auto config = Config::GetSingleton();
-        auto now = std::chrono::steady_clock::now();
+    void BlockEffectsHandler::OnTimedBlockFailed(RE::Actor* blocker, RE::Actor* aggressor) {
+        if (!blocker) return;
 
         std::lock_guard<std::mutex> lock(statesMutex);
 
-        // Check for timeout on all active parry sequences
-        for (auto it = actorStates.begin(); it != actorStates.end();) {
-            auto& [formID, state] = *it;
-
-            if (state.consecutiveCount > 0) {
-                auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-                    now - state.lastParryTime).count();
-
-                // Use dynamic timeout based on current parry count
-                float currentTimeout = state.GetCurrentTimeout(config->parrySequenceTimeoutBase);
+        auto formID = blocker->GetFormID();
+        auto now = std::chrono::steady_clock::now();
+        auto chainAggressor = ChainAggressor(aggressor);
 
-                if (elapsed >= currentTimeout) {
-                    logger::debug("Parry sequence RESET - timeout ({} seconds, limit: {:.1f})",
-                        elapsed, currentTimeout);
-                    state.consecutiveCount = 0;
-                    state.isPerfectParryActive = false;
-                }
-            }
+        if (chains.End(formID, chainAggressor, now)) {
+            logger::debug("Parry sequence RESET - failed block against {:X}", chainAggressor);
+        }
 
-            ++it;
+        if (chains.IsLastAggressor(formID, chainAggressor)) {
+            StateExport::GetSingleton()->SetParryCount(formID, 0);
         }
     }
 
@@ -205,26 +235,19 @@ namespace TheLastBreath {
         std::lock_guard<std::mutex> lock(statesMutex);
 
         auto formID = actor->GetFormID();
-        if (auto it = actorStates.find(formID); it != actorStates.end()) {
-            actorStates.erase(it);
+        if (chains.ClearBlocker(formID)) {
+            StateExport::GetSingleton()->SetParryCount(formID, 0);
         }
     }
 
     BlockEquipmentType BlockEffectsHandler::GetBlockEquipmentType(RE::Actor* blocker) {
         if (!blocker) return BlockEquipmentType::None;
 
-        auto leftEquipped = blocker->GetEquippedObject(true);
-        if (leftEquipped) {
-            if (leftEquipped->IsArmor()) {
-                return BlockEquipmentType::Shield;
-            }
-            if (leftEquipped->IsWeapon()) {
-                return BlockEquipmentType::Weapon;
-            }
+        auto equipment = EquipmentSnapshot::GetSingleton()->Get(blocker);
+        if (equipment.HasShield()) {
+            return BlockEquipmentType::Shield;
         }
-
-        auto rightEquipped = blocker->GetEquippedObject(false);
-        if (rightEquipped && rightEquipped->IsWeapon()) {
+        if (equipment.flags & (kEquipLeftWeapon | kEquipRightWeapon)) {
             return BlockEquipmentType::Weapon;
         }
 
@@ -237,96 +260,54 @@ namespace TheLastBreath {
         auto root3D = blocker->Get3D();
         if (!root3D) return nullptr;
 
-        const char* nodeName = (equipType == BlockEquipmentType::Shield) ? "SHIELD" : "WEAPON";
-        return root3D->GetObjectByName(nodeName);
+        // Interned once - building a BSFixedString per call would hit the string pool every parry
+        static const RE::BSFixedString shieldNode{ "SHIELD" };
+        static const RE::BSFixedString weaponNode{ "WEAPON" };
+        return root3D->GetObjectByName(equipType == BlockEquipmentType::Shield ? shieldNode : weaponNode);
     }
 
-    void BlockEffectsHandler::PlayBlockSpark(RE::Actor* blocker, BlockEquipmentType equipType, uint32_t parryLevel) {
+    void BlockEffectsHandler::PlayBlockSpark(RE::Actor* blocker, BlockEquipmentType equipType, uint32_t parryLevel, bool withRing) {
+        TLB_PROFILE_SCOPE("BlockEffectsHandler::PlayBlockSpark");
         if (!blocker || !blocker->Get3D()) {
             logger::error("PlayBlockSpark: Invalid blocker or missing 3D");
             return;
         }
 
-        // Get the base activator
-        auto activatorBase = Data::BlockFX;
-        if (!activatorBase) {
+        if (!Data::BlockFX) {
             logger::error("BlockFX activator not loaded!");
             return;
         }
 
-        // Spawn the activator at blocker's position
-        auto blockFXNode = Offsets::PlaceAtMe(blocker, activatorBase, 1, false, false);
+        // Pooled activator, already moved to the weapon/shield node
+        const char* nodeName = (equipType == BlockEquipmentType::Shield) ? "SHIELD" : "WEAPON";
+        auto blockFXNode = FxAnchorPool::GetSingleton()->Acquire(blocker, GetBlockEquipmentNode(blocker, equipType));
         if (!blockFXNode) {
-            logger::error("Failed to spawn BlockFX activator!");
+            logger::error("Failed to get a BlockFX anchor!");
             return;
         }
 
-        // Move to weapon/shield node
-        std::string nodeName = (equipType == BlockEquipmentType::Shield) ? "SHIELD" : "WEAPON";
-        blockFXNode->MoveToNode(blocker, nodeName);
-
-        // Spawn explosions based on parry level
-        if (Data::BlockSpark && Data::BlockSparkFlare) {
-            auto spark = Offsets::PlaceAtMe(blockFXNode, Data::BlockSpark, 1, false, false);
-            auto flare = Offsets::PlaceAtMe(blockFXNode, Data::BlockSparkFlare, 1, false, false);
-
-            // Spawn ring explosion for perfect parry (parry 5)
-            if (parryLevel == 5 && Data::BlockSparkRing) {
-                auto ring = Offsets::PlaceAtMe(blockFXNode, Data::BlockSparkRing, 1, false, false);
-                if (spark && flare && ring) {
-                    logger::info("Spawned PERFECT PARRY spark with ring at {} node", nodeName);
-                } else {
-                    logger::warn("Failed to spawn some perfect parry effects (spark: {}, flare: {}, ring: {})",
-                        spark != nullptr, flare != nullptr, ring != nullptr);
-                }
-            }
-            else {
-                if (spark && flare) {
-                    logger::debug("Spawned parry {} spark at {} node", parryLevel, nodeName);
-                } else {
-                    logger::warn("Failed to spawn some parry effects (spark: {}, flare: {})",
-                        spark != nullptr, flare != nullptr);
-                }
-            }
+        // Spawn the explosions this ladder level asks for
+        const auto& level = ParryLadder::GetSingleton()->GetLevel(parryLevel);
+        bool sparkOk = !level.spark || FxAnchorPool::PlaceExplosion(blockFXNode.get(), Data::BlockSpark);
+        bool flareOk = !level.flare || FxAnchorPool::PlaceExplosion(blockFXNode.get(), Data::BlockSparkFlare);
+        bool ringOk = !level.ring || !withRing || FxAnchorPool::PlaceExplosion(blockFXNode.get(), Data::BlockSparkRing);
+
+        if (sparkOk && flareOk && ringOk) {
+            logger::debug("Spawned parry {} effects at {} node (spark: {}, flare: {}, ring: {})",
+                parryLevel, nodeName, level.spark, level.flare, level.ring);
         } else {
-            logger::error("BlockSpark or BlockSparkFlare not loaded!");
+            logger::warn("Failed to spawn some parry {} effects (spark: {}, flare: {}, ring: {})",
+                parryLevel, sparkOk, flareOk, ringOk);
         }
-
-        // Immediately delete the activator
-        blockFXNode->SetDelete(true);
     }
 
     void BlockEffectsHandler::PlayBlockSound(RE::Actor* blocker, BlockEquipmentType equipType, uint32_t parryLevel) {
+        TLB_PROFILE_SCOPE("BlockEffectsHandler::PlayBlockSound");
         if (!blocker) return;
 
-        RE::BGSSoundDescriptorForm* soundDescriptor = nullptr;
-
-        // Get the appropriate sound based on parry level
-        if (parryLevel == 5) {
-            // Perfect parry sound
-            soundDescriptor = (equipType == BlockEquipmentType::Shield)
-                ? Data::parryShieldSoundPerfect
-                : Data::parryWeaponSoundPerfect;
-        }
-        else {
-            // Regular parry sounds (1-4)
-            if (equipType == BlockEquipmentType::Shield) {
-                switch (parryLevel) {
-                case 1: soundDescriptor = Data::parryShieldSound1; break;
-                case 2: soundDescriptor = Data::parryShieldSound2; break;
-                case 3: soundDescriptor = Data::parryShieldSound3; break;
-                case 4: soundDescriptor = Data::parryShieldSound4; break;
-                }
-            }
-            else {
-                switch (parryLevel) {
-                case 1: soundDescriptor = Data::parryWeaponSound1; break;
-                case 2: soundDescriptor = Data::parryWeaponSound2; break;
-                case 3: soundDescriptor = Data::parryWeaponSound3; break;
-                case 4: soundDescriptor = Data::parryWeaponSound4; break;
-                }
-            }
-        }
+        // Each ladder level carries its own weapon and shield sound
+        const auto& level = ParryLadder::GetSingleton()->GetLevel(parryLevel);
+        auto soundDescriptor = (equipType == BlockEquipmentType::Shield) ? level.shieldSound : level.weaponSound;
 
         if (!soundDescriptor) {
             logger::error("Sound descriptor not found for parry level {}", parryLevel);
@@ -345,16 +326,15 @@ namespace TheLastBreath {
                 soundHandle.SetPosition(blocker->GetPosition());
                 soundHandle.SetObjectToFollow(blocker->Get3D());
 
-                // Apply volume from config (0.0 - 1.0)
+                // Apply volume from config (0.0 - 1.0, range enforced by the config schema)
                 auto config = Config::GetSingleton();
-                if (config->parrySoundVolume >= 0.0f && config->parrySoundVolume <= 1.0f) {
-                    soundHandle.SetVolume(config->parrySoundVolume);
-                }
+                soundHandle.SetVolume(config->parrySoundVolume);
 
                 soundHandle.Play();
-                logger::debug("Playing {} parry {} sound (volume: {:.0f}%)",
+                logger::debug("Playing {} parry {}{} sound (volume: {:.0f}%)",
                     equipType == BlockEquipmentType::Shield ? "shield" : "weapon",
-                    parryLevel == 5 ? "PERFECT" : std::to_string(parryLevel),
+                    parryLevel,
+                    ParryLadder::GetSingleton()->IsFinalLevel(parryLevel) ? " PERFECT" : "",
                     config->parrySoundVolume * 100.0f);
             }
         }
@@ -394,6 +374,7 @@ namespace TheLastBreath {
 
         // Trigger stagger
         reactor->NotifyAnimationGraph("staggerStart");
+        Metrics::GetSingleton()->Increment(Counter::Staggers);
 
         logger::trace("Triggered stagger on {} (magnitude: {:.1f}, direction: {:.2f})",
             reactor->GetName(), magnitude, direction);
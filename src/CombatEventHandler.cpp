@@ -2,6 +2,9 @@
 #include "TheLastBreath/AnimationHandler.h"
 #include "TheLastBreath/RangedStaminaHandler.h"
 #include "TheLastBreath/Config.h"
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/SessionRecorder.h"
 
 namespace TheLastBreath {
 
@@ -9,6 +12,7 @@ namespace TheLastBreath {
         const RE::TESCombatEvent* a_event,
         RE::BSTEventSource<RE::TESCombatEvent>* a_eventSource)
     {
+        TLB_PROFILE_SCOPE("CombatEventHandler::ProcessEvent");
         if (!a_event) {
             return RE::BSEventNotifyControl::kContinue;
         }
@@ -29,6 +33,11 @@ namespace TheLastBreath {
             return RE::BSEventNotifyControl::kContinue;
         }
 
+        SessionRecorder::GetSingleton()->RecordCombatState(actor, static_cast<std::uint16_t>(a_event->newState.underlying()));
+
+        // Combat state changed - re-resolve the profile on next lookup
+        ProfileManager::GetSingleton()->InvalidateActor(actor->GetFormID());
+
         // Check if entering combat
         if (a_event->newState.underlying() == 1) {
             std::lock_guard<std::mutex> lock(registrationMutex);
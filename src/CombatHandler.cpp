@@ -1,5 +1,15 @@
 #include "TheLastBreath/CombatHandler.h"
+#include "TheLastBreath/ActorValueCache.h"
 #include "TheLastBreath/Config.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+#include "TheLastBreath/HitProcessor.h"
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/StaminaLedger.h"
+#include "TheLastBreath/Telemetry.h"
+#include "TheLastBreath/StateExport.h"
+#include "TheLastBreath/WeaponStatsCache.h"
 
 namespace TheLastBreath {
 
@@ -7,20 +17,14 @@ namespace TheLastBreath {
         if (!actor) return;
 
         auto config = Config::GetSingleton();
-        if (!config->enableStaminaManagement || !config->enableBlockStaminaDrain) {
+        if (!config->derived.blockDrain) {
             return;
         }
 
         // ============================================
         // CHECK: Only apply block drain for shields/weapons, NOT bows
         // ============================================
-        bool hasBowEquipped = false;
-        if (const auto obj = actor->GetEquippedObject(false)) {
-            if (const auto weap = obj->As<RE::TESObjectWEAP>()) {
-                const auto wt = weap->GetWeaponType();
-                hasBowEquipped = (wt == RE::WEAPON_TYPE::kBow || wt == RE::WEAPON_TYPE::kCrossbow);
-            }
-        }
+        bool hasBowEquipped = EquipmentSnapshot::GetSingleton()->Get(actor).HasRanged();
 
         if (hasBowEquipped) {
             logger::debug("Block button pressed but bow equipped - no stamina drain");
@@ -48,84 +52,105 @@ namespace TheLastBreath {
 
         std::lock_guard<std::mutex> lock(statesMutex);
 
+        // Entry is kept so the next block press doesn't allocate a map node
         auto formID = actor->GetFormID();
         auto it = actorBlockStates.find(formID);
-        if (it != actorBlockStates.end()) {
+        if (it != actorBlockStates.end() && it->second.isBlocking) {
             logger::debug("Block stopped - stamina drain ends");
-            actorBlockStates.erase(it);
+            it->second.isBlocking = false;
+        }
+    }
+
+    float CombatHandler::GetBlockHoldCostPerSecond(RE::Actor* actor) {
+        float cost = ProfileManager::GetSingleton()->GetProfile(actor).blockHoldStaminaCostPerSecond;
+
+        // Heavier shields and weapons are harder to hold up
+        float perWeight = Config::GetSingleton()->blockHoldStaminaCostPerWeight;
+        if (perWeight > 0.0f) {
+            if (auto item = WeaponStatsCache::GetSingleton()->GetBlockingItem(actor)) {
+                cost += perWeight * item->weight;
+            }
         }
+        return cost;
     }
 
     void CombatHandler::Update() {
+        TLB_PROFILE_SCOPE("CombatHandler::Update");
         auto config = Config::GetSingleton();
-        if (!config->enableStaminaManagement || !config->enableBlockStaminaDrain) {
+        if (!config->derived.blockDrain) {
             return;
         }
 
         std::lock_guard<std::mutex> lock(statesMutex);
 
         auto now = std::chrono::steady_clock::now();
+        std::int64_t blockingActors = 0;
 
         // Handle block stamina drain
         for (auto it = actorBlockStates.begin(); it != actorBlockStates.end();) {
             auto& [formID, state] = *it;
 
-            if (!state.isBlocking) {
+            // Idle entries are kept for the next press, but not for actors that are gone or unloaded
+            RE::Actor* actor = RE::TESForm::LookupByID<RE::Actor>(formID);
+            if (!actor || actor->IsDisabled() || actor->IsDeleted() || (!state.isBlocking && !actor->Is3DLoaded())) {
                 it = actorBlockStates.erase(it);
                 continue;
             }
 
-            RE::Actor* actor = RE::TESForm::LookupByID<RE::Actor>(formID);
-            if (!actor || actor->IsDisabled() || actor->IsDeleted()) {
-                it = actorBlockStates.erase(it);
+            if (!state.isBlocking) {
+                ++it;
                 continue;
             }
 
             // ============================================
             // SAFETY CHECK: Stop drain if bow is now equipped
             // ============================================
-            bool hasBowEquipped = false;
-            if (const auto obj = actor->GetEquippedObject(false)) {
-                if (const auto weap = obj->As<RE::TESObjectWEAP>()) {
-                    const auto wt = weap->GetWeaponType();
-                    hasBowEquipped = (wt == RE::WEAPON_TYPE::kBow || wt == RE::WEAPON_TYPE::kCrossbow);
-                }
-            }
+            bool hasBowEquipped = EquipmentSnapshot::GetSingleton()->Get(actor).HasRanged();
 
             if (hasBowEquipped) {
                 logger::debug("Bow equipped during block drain - stopping");
-                it = actorBlockStates.erase(it);
+                state.isBlocking = false;
+                ++it;
                 continue;
             }
 
+            const float costPerSecond = GetBlockHoldCostPerSecond(actor);
+
+            if (auto exporter = StateExport::GetSingleton(); exporter->IsEnabled()) {
+                exporter->SetDrain(formID, SharedState::DrainSource::BlockHold, costPerSecond);
+            }
+
             auto blockElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
                 now - state.lastBlockDrainTime).count();
 
             if (blockElapsed >= 200) {
-                const float current = actor->AsActorValueOwner()->GetActorValue(RE::ActorValue::kStamina);
+                const float current = ActorValueCache::GetSingleton()->Get(actor, CachedValue::Stamina);
                 if (current <= 0.1f) {
                     logger::debug("Stamina exhausted - stopping block drain");
-                    it = actorBlockStates.erase(it);
+                    state.isBlocking = false;
+                    ++it;
                     continue;
                 }
 
                 const float secondsElapsed = static_cast<float>(blockElapsed) / 1000.0f;
-                const float costThisTick = config->blockHoldStaminaCostPerSecond * secondsElapsed;
+                const float costThisTick = costPerSecond * secondsElapsed;
                 const float actualCost = std::min(costThisTick, current);
 
-                actor->AsActorValueOwner()->RestoreActorValue(
-                    RE::ACTOR_VALUE_MODIFIER::kDamage,
-                    RE::ActorValue::kStamina,
-                    -actualCost);
+                StaminaLedger::GetSingleton()->Post(actor, LedgerSource::BlockHold, -actualCost);
 
                 logger::debug("Block hold drain: {:.2f} stamina ({} ms since last)",
                     actualCost, static_cast<int>(blockElapsed));
+                Metrics::GetSingleton()->Increment(Counter::BlockDrainTicks);
+                Telemetry::GetSingleton()->RecordStamina(actor, StaminaSource::BlockHold, actualCost);
 
                 state.lastBlockDrainTime = now;
             }
 
+            ++blockingActors;
             ++it;
         }
+
+        Metrics::GetSingleton()->SetGauge(Gauge::BlockDrainActors, blockingActors);
     }
 
     void CombatHandler::OnActorHit(RE::Actor* victim, RE::Actor* aggressor, float actualDamage, BlockType blockType) {
@@ -146,7 +171,7 @@ namespace TheLastBreath {
         // ============================================
         // STAMINA LOSS ON HIT (Regular blocks and no blocks)
         // ============================================
-        if (!config->enableStaminaManagement || !config->enableStaminaLossOnHit) {
+        if (!config->derived.staminaLossOnHit) {
             return;
         }
 
@@ -154,13 +179,31 @@ namespace TheLastBreath {
         float baseLoss = CalculateBaseStaminaLoss(victim);
 
         if (blockType == BlockType::Regular) {
-            ProcessRegularBlock(victim, baseLoss);
+            ProcessRegularBlock(victim, aggressor, baseLoss);
         }
         else if (blockType == BlockType::None) {
-            ProcessUnblockedHit(victim, baseLoss);
+            ProcessUnblockedHit(victim, aggressor, baseLoss);
         }
     }
 
+    void CombatHandler::OnProjectileParried(RE::Actor* victim, RE::Actor* shooter, float actualDamage,
+        RE::ObjectRefHandle projectile) {
+        if (!ShouldProcessHit(victim) || !shooter) {
+            return;
+        }
+
+        // The pre-damage hook only sees melee hits, so a projectile hit has always landed in full:
+        // heal back the timed block reduction even with the hook enabled
+        HealBackTimedBlockDamage(victim, actualDamage);
+        HitProcessor::DestroyProjectile(projectile);
+
+        logger::info("=== PROJECTILE DEFLECTED ===");
+        Metrics::GetSingleton()->Increment(Counter::ProjectileParries);
+
+        BlockEffectsHandler::GetSingleton()->OnProjectileDeflected(victim);
+        ApplyTimedBlockStamina(victim);
+    }
+
     bool CombatHandler::ShouldProcessHit(RE::Actor* victim) {
         if (!victim) return false;
         if (!victim->IsPlayerRef()) return false;
@@ -170,7 +213,7 @@ namespace TheLastBreath {
     float CombatHandler::CalculateBaseStaminaLoss(RE::Actor* victim) {
         auto config = Config::GetSingleton();
 
-        float maxStamina = victim->AsActorValueOwner()->GetPermanentActorValue(RE::ActorValue::kStamina);
+        float maxStamina = ActorValueCache::GetSingleton()->Get(victim, CachedValue::PermanentStamina);
         float baseLoss = (config->staminaLossBaseIntercept - (config->staminaLossScalingFactor * maxStamina))
             + config->staminaLossFlatAddition;
         baseLoss = std::max(0.0f, baseLoss);
@@ -187,6 +230,17 @@ namespace TheLastBreath {
         // Trigger visual/audio effects and stagger
         BlockEffectsHandler::GetSingleton()->OnSuccessfulTimedBlock(victim, aggressor);
 
+        // The pre-damage hook already reduced the hit when enabled
+        if (!config->usePreDamageHook) {
+            HealBackTimedBlockDamage(victim, actualDamage);
+        }
+
+        ApplyTimedBlockStamina(victim);
+    }
+
+    void CombatHandler::HealBackTimedBlockDamage(RE::Actor* victim, float actualDamage) {
+        auto config = Config::GetSingleton();
+
         // ============================================
         // DAMAGE REDUCTION VIA HEAL-BACK
         // ============================================
@@ -203,6 +257,10 @@ namespace TheLastBreath {
                 config->timedBlockDamageReduction * 100.0f,
                 actualDamage);
         }
+    }
+
+    void CombatHandler::ApplyTimedBlockStamina(RE::Actor* victim) {
+        auto config = Config::GetSingleton();
 
         // Stamina handling for timed blocks
         if (config->enableStaminaManagement) {
@@ -213,32 +271,27 @@ namespace TheLastBreath {
                 float timedBlockLoss = regularBlockLoss * config->timedBlockStaminaAmountLossMult;
 
                 if (timedBlockLoss > 0.0f) {
-                    victim->AsActorValueOwner()->RestoreActorValue(
-                        RE::ACTOR_VALUE_MODIFIER::kDamage,
-                        RE::ActorValue::kStamina,
-                        -timedBlockLoss);
+                    StaminaLedger::GetSingleton()->Post(victim, LedgerSource::HitLoss, -timedBlockLoss);
                     logger::info("Timed block stamina LOSS: {:.2f}", timedBlockLoss);
+                    Telemetry::GetSingleton()->RecordStamina(victim, StaminaSource::HitLoss, timedBlockLoss);
                 }
             }
             else if (config->timedBlockStaminaGain) {
                 float staminaGain = config->timedBlockStaminaAmountGain;
                 if (staminaGain > 0.0f) {
-                    victim->AsActorValueOwner()->RestoreActorValue(
-                        RE::ACTOR_VALUE_MODIFIER::kDamage,
-                        RE::ActorValue::kStamina,
-                        staminaGain);
+                    StaminaLedger::GetSingleton()->Post(victim, LedgerSource::TimedBlockGain, staminaGain);
                     logger::info("Timed block stamina GAIN: {:.2f}", staminaGain);
                 }
             }
         }
     }
 
-    void CombatHandler::ProcessRegularBlock(RE::Actor* victim, float baseLoss) {
+    void CombatHandler::ProcessRegularBlock(RE::Actor* victim, RE::Actor* aggressor, float baseLoss) {
         auto config = Config::GetSingleton();
 
         // Clear timed block state AND reset counter
         TimedBlockHandler::GetSingleton()->ClearActor(victim);
-        BlockEffectsHandler::GetSingleton()->OnTimedBlockFailed(victim);
+        BlockEffectsHandler::GetSingleton()->OnTimedBlockFailed(victim, aggressor);
 
         // Sub-toggle: only lose stamina on regular block if enabled
         if (!config->enableRegularBlockStaminaLossOnHit) {
@@ -250,27 +303,23 @@ namespace TheLastBreath {
         logger::debug("Regular block - stamina loss: {:.2f}", finalLoss);
 
         if (finalLoss > 0.0f) {
-            victim->AsActorValueOwner()->RestoreActorValue(
-                RE::ACTOR_VALUE_MODIFIER::kDamage,
-                RE::ActorValue::kStamina,
-                -finalLoss);
+            StaminaLedger::GetSingleton()->Post(victim, LedgerSource::HitLoss, -finalLoss);
+            Telemetry::GetSingleton()->RecordStamina(victim, StaminaSource::HitLoss, finalLoss);
         }
     }
 
-    void CombatHandler::ProcessUnblockedHit(RE::Actor* victim, float baseLoss) {
+    void CombatHandler::ProcessUnblockedHit(RE::Actor* victim, RE::Actor* aggressor, float baseLoss) {
 
         // Reset timed block counter since no block happened
-        BlockEffectsHandler::GetSingleton()->OnTimedBlockFailed(victim);
+        BlockEffectsHandler::GetSingleton()->OnTimedBlockFailed(victim, aggressor);
 
         // No sub-toggle - always lose stamina when hit without blocking
         logger::debug("No block - stamina loss: {:.2f}", baseLoss);
 
         if (baseLoss > 0.0f) {
 
-            victim->AsActorValueOwner()->RestoreActorValue(
-                RE::ACTOR_VALUE_MODIFIER::kDamage,
-                RE::ActorValue::kStamina,
-                -baseLoss);
+            StaminaLedger::GetSingleton()->Post(victim, LedgerSource::HitLoss, -baseLoss);
+            Telemetry::GetSingleton()->RecordStamina(victim, StaminaSource::HitLoss, baseLoss);
         }
     }
 
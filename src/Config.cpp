@@ -1,8 +1,325 @@
 #include "TheLastBreath/Config.h"
 #include <SimpleIni.h>
+#include <variant>
 
 namespace TheLastBreath {
 
+    namespace {
+
+        // ============================================
+        // SETTINGS SCHEMA
+        // Single source of truth for every INI setting: Load, Save,
+        // defaults and range validation are all driven from this table.
+        // ============================================
+
+        using Member = std::variant<bool Config::*, float Config::*, int Config::*, uint32_t Config::*>;
+
+        struct Setting {
+            std::string_view section;
+            std::string_view key;
+            Member member;
+            double defaultValue;
+            double minValue;
+            double maxValue;
+            std::string_view description;
+        };
+
+        constexpr Setting Bool(std::string_view section, std::string_view key, bool Config::* member,
+            bool defaultValue, std::string_view description) {
+            return { section, key, member, defaultValue ? 1.0 : 0.0, 0.0, 1.0, description };
+        }
+
+        constexpr Setting Float(std::string_view section, std::string_view key, float Config::* member,
+            double defaultValue, double minValue, double maxValue, std::string_view description) {
+            return { section, key, member, defaultValue, minValue, maxValue, description };
+        }
+
+        constexpr Setting Int(std::string_view section, std::string_view key, int Config::* member,
+            int defaultValue, int minValue, int maxValue, std::string_view description) {
+            return { section, key, member, static_cast<double>(defaultValue),
+                static_cast<double>(minValue), static_cast<double>(maxValue), description };
+        }
+
+        constexpr Setting UInt(std::string_view section, std::string_view key, uint32_t Config::* member,
+            uint32_t defaultValue, uint32_t minValue, uint32_t maxValue, std::string_view description) {
+            return { section, key, member, static_cast<double>(defaultValue),
+                static_cast<double>(minValue), static_cast<double>(maxValue), description };
+        }
+
+        constexpr std::array kSettings{
+            // [Stamina]
+            Bool("Stamina", "bEnableStaminaManagement", &Config::enableStaminaManagement, true,
+                "Enable/disable all stamina management features"),
+            Bool("Stamina", "bEnableJumpStaminaCost", &Config::enableJumpStaminaCost, true,
+                "Enable stamina cost when jumping"),
+            Float("Stamina", "fJumpStaminaCost", &Config::jumpStaminaCost, 10.0, 0.0, 1000.0,
+                "Flat stamina cost per jump"),
+            Bool("Stamina", "bEnableBlockStaminaDrain", &Config::enableBlockStaminaDrain, true,
+                "Enable continuous stamina drain while blocking"),
+            Float("Stamina", "fBlockHoldStaminaCostPerSecond", &Config::blockHoldStaminaCostPerSecond, 2.0, 0.0, 1000.0,
+                "Stamina drain per second while blocking"),
+            Float("Stamina", "fBlockHoldStaminaCostPerWeight", &Config::blockHoldStaminaCostPerWeight, 0.0, 0.0, 100.0,
+                "Extra block drain per second for each point of weight of the shield (or weapon) blocking"),
+            Bool("Stamina", "bEnableLightAttackStamina", &Config::enableLightAttackStamina, true,
+                "Enable light attack stamina cost system"),
+            Float("Stamina", "fLightAttackStaminaCost", &Config::lightAttackStaminaCostMult, 0.15, 0.0, 10.0,
+                "Light attack stamina cost as % of power attack (0.3 = 30%, 1.0 = same as power attack)"),
+            Bool("Stamina", "bClosedFormAttackCost", &Config::closedFormAttackCost, true,
+                "Compute the power attack baseline from weapon weight and game settings instead of asking the engine, once the first power attack confirms the formula"),
+            Bool("Stamina", "bEnableRangedStaminaCost", &Config::enableRangedStaminaCost, true,
+                "Master toggle for ranged (bow & crossbow) stamina costs"),
+            Bool("Stamina", "bEnableRangedHoldStaminaDrain", &Config::enableRangedHoldStaminaDrain, true,
+                "Enable continuous stamina drain while holding bow/crossbow drawn"),
+            Float("Stamina", "fRangedHoldStaminaCostPerSecond", &Config::rangedHoldStaminaCostPerSecond, 3.0, 0.0, 1000.0,
+                "Stamina drain per second while aiming"),
+            Float("Stamina", "fRangedHoldStaminaCostPerWeight", &Config::rangedHoldStaminaCostPerWeight, 0.0, 0.0, 100.0,
+                "Extra aiming drain per second for each point of weight of the bow/crossbow"),
+            Bool("Stamina", "bEnableRangedReleaseStaminaCost", &Config::enableRangedReleaseStaminaCost, true,
+                "Enable stamina cost when firing arrow"),
+            Float("Stamina", "fRangedReleaseStaminaCost", &Config::rangedReleaseStaminaCost, 10.0, 0.0, 1000.0,
+                "Stamina cost when firing"),
+            Bool("Stamina", "bEnableRapidComboStaminaCost", &Config::enableRapidComboStaminaCost, false,
+                "Enable stamina cost for rapid combo arrows (Bow Rapid Combo V3)"),
+            Float("Stamina", "fRapidComboStaminaCost", &Config::rapidComboStaminaCost, 10.0, 0.0, 1000.0,
+                "Stamina cost per rapid combo arrow"),
+
+            // [Combat]
+            Bool("Combat", "bEnableStaminaLossOnHit", &Config::enableStaminaLossOnHit, true,
+                "Enable stamina loss when player is hit (no block)"),
+            Float("Combat", "fStaminaLossBaseIntercept", &Config::staminaLossBaseIntercept, 14.5, 0.0, 1000.0,
+                "Stamina loss formula: (BaseIntercept - (ScalingFactor * MaxStamina)) + FlatAddition"),
+            Float("Combat", "fStaminaLossScalingFactor", &Config::staminaLossScalingFactor, 0.018, 0.0, 10.0,
+                "How much to reduce stamina loss per point of max stamina"),
+            Float("Combat", "fStaminaLossFlatAddition", &Config::staminaLossFlatAddition, 1.0, 0.0, 1000.0,
+                "Flat amount always added to the stamina loss"),
+            Bool("Combat", "bEnableRegularBlockStaminaLossOnHit", &Config::enableRegularBlockStaminaLossOnHit, true,
+                "Enable stamina loss when blocking (regular block, not timed)"),
+            Float("Combat", "fRegularBlockStaminaMult", &Config::regularBlockStaminaMult, 0.5, 0.0, 10.0,
+                "Stamina multiplier for regular blocks (0.5 = half loss, 2.0 = double loss)"),
+            Float("Combat", "fHitDeduplicationWindow", &Config::hitDeduplicationWindow, 0.0, 0.0, 1.0,
+                "Repeat hit events (same attacker, weapon, projectile and hit flags) in one frame always count once. Above 0, repeats up to this many seconds later are ignored too, which also merges real strikes that close together"),
+
+            // [Exhaustion]
+            Bool("Exhaustion", "bEnableExhaustionDebuff", &Config::enableExhaustionDebuff, true,
+                "Enable exhaustion debuffs when stamina is low"),
+            Float("Exhaustion", "fExhaustionStaminaThreshold", &Config::exhaustionStaminaThreshold, 20.0, 0.0, 1000.0,
+                "Debuffs apply when current stamina < this value"),
+            Float("Exhaustion", "fExhaustionMovementSpeedDebuff", &Config::exhaustionMovementSpeedDebuff, 0.20, 0.0, 1.0,
+                "Movement speed debuff (0.20 = 20% slower)"),
+            Float("Exhaustion", "fExhaustionAttackDamageDebuff", &Config::exhaustionAttackDamageDebuff, 0.25, 0.0, 1.0,
+                "Attack damage debuff (0.25 = 25% less damage dealt)"),
+
+            // [TimedBlocking]
+            Bool("TimedBlocking", "bEnableTimedBlocking", &Config::enableTimedBlocking, true,
+                "Enable timed blocking system"),
+            Bool("TimedBlocking", "bEnableTimedBlockSkillRequirement", &Config::enableTimedBlockSkillRequirement, false,
+                "Require a minimum block skill for timed blocks"),
+            Float("TimedBlocking", "fTimedBlockRequiredSkillLevel", &Config::timedBlockRequiredSkillLevel, 0.0, 0.0, 100.0,
+                "Minimum block skill for timed blocks"),
+            Float("TimedBlocking", "fTimedBlockAnimationDelay", &Config::timedBlockAnimationDelay, 0.05, 0.0, 1.0,
+                "Animation delay before timed window starts (seconds)"),
+            UInt("TimedBlocking", "iBlockButton", &Config::blockButton, 257, 0, 512,
+                "Block button universal key code (Mouse: 256=left, 257=right, 258=middle; Keyboard: scan codes; Gamepad: 266+)"),
+            Bool("TimedBlocking", "bTimedBlockStaminaLoss", &Config::timedBlockStaminaLoss, false,
+                "Enable stamina LOSS on timed block"),
+            Bool("TimedBlocking", "bTimedBlockStaminaGain", &Config::timedBlockStaminaGain, true,
+                "Enable stamina GAIN on timed block"),
+            Float("TimedBlocking", "fTimedBlockStaminaAmountGain", &Config::timedBlockStaminaAmountGain, 20.0, 0.0, 1000.0,
+                "Flat stamina gain on timed block"),
+            Float("TimedBlocking", "fTimedBlockStaminaAmountLossMult", &Config::timedBlockStaminaAmountLossMult, 0.5, 0.0, 10.0,
+                "Stamina loss multiplier (applied to regular block loss)"),
+            Float("TimedBlocking", "fTimedBlockDamageReduction", &Config::timedBlockDamageReduction, 1.0, 0.0, 1.0,
+                "Damage reduction for timed blocks (1.0 = 100% negated, 0.5 = 50% reduction)"),
+            Bool("TimedBlocking", "bUsePreDamageHook", &Config::usePreDamageHook, false,
+                "Apply timed block damage reduction before damage lands (hooks the melee hit call) instead of healing it back afterwards"),
+            Bool("TimedBlocking", "bEnableProjectileParry", &Config::enableProjectileParry, true,
+                "Timed blocks against arrows and bolts deflect them instead of staggering the shooter at range. Damage reduction and stamina follow the timed block settings"),
+            Bool("TimedBlocking", "bDestroyParriedProjectiles", &Config::destroyParriedProjectiles, true,
+                "Remove a deflected projectile instead of leaving it stuck in the shield"),
+            Bool("TimedBlocking", "bSlowTimeOnlyOnPerfectParry", &Config::slowTimeOnlyOnPerfectParry, true,
+                "Only slow time on perfect parry instead of every timed block"),
+            Float("TimedBlocking", "fSlowTimeDuration", &Config::slowTimeDuration, 0.5, 0.0, 10.0,
+                "Slow time duration in seconds"),
+            Float("TimedBlocking", "fSlowTimePercentage", &Config::slowTimePercentage, 0.4, 0.0, 1.0,
+                "Time speed during slow time (0.1 = 10% speed)"),
+
+            // [ParrySystem]
+            Bool("ParrySystem", "bEnableParryStagger", &Config::enableParryStagger, true,
+                "Enable light stagger on every parry before the final ladder level"),
+            Bool("ParrySystem", "bEnablePerfectParry", &Config::enablePerfectParry, true,
+                "Enable perfect parry (final ladder level) with guard break"),
+            Float("ParrySystem", "fParrySequenceTimeoutBase", &Config::parrySequenceTimeoutBase, 2.0, 0.0, 60.0,
+                "Base sequence timeout in seconds (each ladder level adds its fTimeoutIncrement)"),
+            Bool("ParrySystem", "bGlobalParryChain", &Config::globalParryChain, false,
+                "One parry sequence for all attackers instead of one per attacker"),
+            Float("ParrySystem", "fParrySoundVolume", &Config::parrySoundVolume, 1.0, 0.0, 1.0,
+                "Parry sound volume (0.0 = mute, 1.0 = full volume)"),
+            Bool("ParrySystem", "bEnableParrySparks", &Config::enableParrySparks, true,
+                "Toggle parry spark visuals"),
+
+            // [EldenCounter]
+            Bool("EldenCounter", "bEnableEldenCounter", &Config::enableEldenCounter, false,
+                "Enable Elden Counter integration"),
+            Bool("EldenCounter", "bEldenCounterOnlyTimedBlocks", &Config::eldenCounterOnlyTimedBlocks, true,
+                "Only trigger Elden Counter on successful timed blocks"),
+            Bool("EldenCounter", "bEldenCounterOnlyPerfectParry", &Config::eldenCounterOnlyPerfectParry, false,
+                "Only trigger Elden Counter on perfect parry"),
+
+            // [FrameBudget]
+            Bool("FrameBudget", "bEnableFrameGovernor", &Config::enableFrameGovernor, false,
+                "Shed parry cosmetics (ring, sparks, slow time length) when frames run over budget. Stagger, stamina and sound are never shed"),
+            Float("FrameBudget", "fFrameBudgetMs", &Config::frameBudgetMs, 16.7, 1.0, 100.0,
+                "Minimum frame budget in milliseconds (16.7 = 60 FPS). The budget is this or the player's average frame time over the last few seconds, whichever is longer"),
+            Float("FrameBudget", "fShedRingAt", &Config::shedRingAt, 1.25, 0.1, 10.0,
+                "Drop the ring flare when the projected frame time reaches this multiple of the budget"),
+            Float("FrameBudget", "fShedSparksAt", &Config::shedSparksAt, 1.5, 0.1, 10.0,
+                "Drop the sparks and flare when the projected frame time reaches this multiple of the budget"),
+            Float("FrameBudget", "fShortenSlowTimeAt", &Config::shortenSlowTimeAt, 2.0, 0.1, 10.0,
+                "Shorten slow time when the projected frame time reaches this multiple of the budget"),
+            Float("FrameBudget", "fShedSlowTimeMult", &Config::shedSlowTimeMult, 0.5, 0.0, 1.0,
+                "Slow time duration multiplier once shortened (0 = skip slow time)"),
+
+            // [NPCs]
+            Bool("NPCs", "bApplyToNPCs", &Config::applyToNPCs, true,
+                "Apply stamina costs to NPCs in combat"),
+
+            // [Debug]
+            Int("Debug", "iLogLevel", &Config::logLevel, 1, 0, 6,
+                "Log Level: 0=trace, 1=debug, 2=info, 3=warn, 4=error, 5=critical, 6=off"),
+            Bool("Debug", "bEnableMetrics", &Config::enableMetrics, false,
+                "Collect counters and latency histograms and write them to TheLastBreath_Stats.txt next to the log"),
+            Float("Debug", "fMetricsFlushInterval", &Config::metricsFlushInterval, 60.0, 1.0, 3600.0,
+                "Seconds between stats file writes"),
+            UInt("Debug", "iProfilerHotkey", &Config::profilerHotkey, 0, 0, 512,
+                "Universal key code that starts/stops a trace capture, 0 = disabled (profiler builds only)"),
+            Float("Debug", "fProfilerCaptureDuration", &Config::profilerCaptureDuration, 10.0, 0.0, 600.0,
+                "Seconds before a trace capture stops by itself, 0 = until the hotkey is pressed again"),
+            Bool("Debug", "bProfilerCaptureOnLoad", &Config::profilerCaptureOnLoad, false,
+                "Start a trace capture as soon as a save is loaded (profiler builds only)"),
+            Bool("Debug", "bRecordAttackCosts", &Config::recordAttackCosts, false,
+                "Append the closed-form cost inputs and the engine's cost of every power attack to TheLastBreath_AttackCosts.csv next to the log (test data for the attack cost model)"),
+            Bool("Debug", "bRecordSessions", &Config::recordSessions, false,
+                "Record block input, hits and combat events to TheLastBreath_Session_N.tlbr next to the log for offline replay"),
+            Bool("Debug", "bEnableTelemetry", &Config::enableTelemetry, false,
+                "Append one row of parry, block and stamina totals per player combat encounter to TheLastBreath_Encounters.txt"),
+            Bool("Debug", "bExportSharedState", &Config::exportSharedState, false,
+                "Publish live parry, block window, stamina drain and exhaustion state in shared memory for overlays and tools"),
+        };
+
+        // ============================================
+        // COMPILE TIME SCHEMA CHECKS
+        // ============================================
+
+        constexpr char KeyPrefix(const Member& member) {
+            switch (member.index()) {
+            case 0: return 'b';
+            case 1: return 'f';
+            default: return 'i';
+            }
+        }
+
+        constexpr bool SameMember(const Member& a, const Member& b) {
+            if (a.index() != b.index()) return false;
+            return std::visit([&](auto ptr) { return ptr == std::get<decltype(ptr)>(b); }, a);
+        }
+
+        constexpr bool ValidateSchema() {
+            for (std::size_t i = 0; i < kSettings.size(); ++i) {
+                const auto& setting = kSettings[i];
+
+                if (setting.section.empty() || setting.key.empty() || setting.description.empty()) return false;
+                if (setting.key.front() != KeyPrefix(setting.member)) return false;
+                if (setting.minValue > setting.maxValue) return false;
+                if (setting.defaultValue < setting.minValue || setting.defaultValue > setting.maxValue) return false;
+
+                for (std::size_t j = i + 1; j < kSettings.size(); ++j) {
+                    if (setting.section == kSettings[j].section && setting.key == kSettings[j].key) return false;
+                    if (SameMember(setting.member, kSettings[j].member)) return false;
+                }
+            }
+            return true;
+        }
+
+        static_assert(ValidateSchema(),
+            "Config schema is invalid: check key prefixes, ranges, defaults and duplicate keys/members");
+
+        // ============================================
+        // LOAD / SAVE HELPERS
+        // ============================================
+
+        template <class T>
+        T Validate(const Setting& setting, double value) {
+            if (value < setting.minValue || value > setting.maxValue) {
+                logger::warn("[{}] {} = {} is out of range [{}, {}], clamping",
+                    setting.section, setting.key, value, setting.minValue, setting.maxValue);
+                value = std::clamp(value, setting.minValue, setting.maxValue);
+            }
+            return static_cast<T>(value);
+        }
+
+        void Read(const CSimpleIniA& ini, const Setting& setting, bool& field) {
+            field = ini.GetBoolValue(setting.section.data(), setting.key.data(), setting.defaultValue != 0.0);
+        }
+
+        void Read(const CSimpleIniA& ini, const Setting& setting, float& field) {
+            field = Validate<float>(setting,
+                ini.GetDoubleValue(setting.section.data(), setting.key.data(), setting.defaultValue));
+        }
+
+        template <class T>
+        void Read(const CSimpleIniA& ini, const Setting& setting, T& field) {
+            field = Validate<T>(setting, static_cast<double>(
+                ini.GetLongValue(setting.section.data(), setting.key.data(), static_cast<long>(setting.defaultValue))));
+        }
+
+        void Write(CSimpleIniA& ini, const Setting& setting, const std::string& comment, bool value) {
+            ini.SetBoolValue(setting.section.data(), setting.key.data(), value, comment.c_str());
+        }
+
+        void Write(CSimpleIniA& ini, const Setting& setting, const std::string& comment, float value) {
+            ini.SetDoubleValue(setting.section.data(), setting.key.data(), value, comment.c_str());
+        }
+
+        template <class T>
+        void Write(CSimpleIniA& ini, const Setting& setting, const std::string& comment, T value) {
+            ini.SetLongValue(setting.section.data(), setting.key.data(), static_cast<long>(value), comment.c_str());
+        }
+
+        void WriteAll(const Config& config, CSimpleIniA& ini) {
+            for (const auto& setting : kSettings) {
+                std::string comment = "; ";
+                comment += setting.description;
+                std::visit([&](auto member) { Write(ini, setting, comment, config.*member); }, setting.member);
+            }
+        }
+
+    }
+
+    Config::Config() {
+        for (const auto& setting : kSettings) {
+            std::visit([&](auto member) {
+                using T = std::remove_reference_t<decltype(this->*member)>;
+                this->*member = static_cast<T>(setting.defaultValue);
+            }, setting.member);
+        }
+        ComputeDerived();
+    }
+
+    void Config::ComputeDerived() {
+        derived.blockDrain = enableStaminaManagement && enableBlockStaminaDrain;
+        derived.staminaLossOnHit = enableStaminaManagement && enableStaminaLossOnHit;
+        derived.jumpCost = enableStaminaManagement && enableJumpStaminaCost;
+        derived.rangedCost = enableStaminaManagement && enableRangedStaminaCost;
+        derived.rangedHoldDrain = derived.rangedCost && enableRangedHoldStaminaDrain;
+
+        derived.hitDeduplicationWindow = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(hitDeduplicationWindow));
+
+        derived.shedRingMs = frameBudgetMs * shedRingAt;
+        derived.shedSparksMs = frameBudgetMs * shedSparksAt;
+        derived.shortenSlowTimeMs = frameBudgetMs * shortenSlowTimeAt;
+    }
+
     std::filesystem::path Config::GetConfigPath() {
         return std::filesystem::path("Data/SKSE/Plugins/TheLastBreath.ini");
     }
@@ -20,156 +337,32 @@ namespace TheLastBreath {
             return;
         }
 
-        // [Stamina]
-        enableStaminaManagement = ini.GetBoolValue("Stamina", "bEnableStaminaManagement", true);
-        enableJumpStaminaCost = ini.GetBoolValue("Stamina", "bEnableJumpStaminaCost", true);
-        jumpStaminaCost = static_cast<float>(ini.GetDoubleValue("Stamina", "fJumpStaminaCost", 10.0));
-        enableBlockStaminaDrain = ini.GetBoolValue("Stamina", "bEnableBlockStaminaDrain", true);
-        blockHoldStaminaCostPerSecond = static_cast<float>(ini.GetDoubleValue("Stamina", "fBlockHoldStaminaCostPerSecond", 2.0));
-
-        enableLightAttackStamina = ini.GetBoolValue("Stamina", "bEnableLightAttackStamina", false);
-        lightAttackStaminaCostMult = static_cast<float>(ini.GetDoubleValue("Stamina", "fLightAttackStaminaCost", 0.15));
-
-        enableRangedStaminaCost = ini.GetBoolValue("Stamina", "bEnableRangedStaminaCost", true);
-        enableRangedHoldStaminaDrain = ini.GetBoolValue("Stamina", "bEnableRangedHoldStaminaDrain", false);
-        rangedHoldStaminaCostPerSecond = static_cast<float>(ini.GetDoubleValue("Stamina", "fRangedHoldStaminaCostPerSecond", 3.0));
-        enableRangedReleaseStaminaCost = ini.GetBoolValue("Stamina", "bEnableRangedReleaseStaminaCost", true);
-        rangedReleaseStaminaCost = static_cast<float>(ini.GetDoubleValue("Stamina", "fRangedReleaseStaminaCost", 10.0));
-        enableRapidComboStaminaCost = ini.GetBoolValue("Stamina", "bEnableRapidComboStaminaCost", true);
-        rapidComboStaminaCost = static_cast<float>(ini.GetDoubleValue("Stamina", "fRapidComboStaminaCost", 10.0));
-
-        // [Combat]
-        enableStaminaLossOnHit = ini.GetBoolValue("Combat", "bEnableStaminaLossOnHit", true);
-        staminaLossBaseIntercept = static_cast<float>(ini.GetDoubleValue("Combat", "fStaminaLossBaseIntercept", 14.5));
-        staminaLossScalingFactor = static_cast<float>(ini.GetDoubleValue("Combat", "fStaminaLossScalingFactor", 0.018));
-        staminaLossFlatAddition = static_cast<float>(ini.GetDoubleValue("Combat", "fStaminaLossFlatAddition", 1.0));
-        enableRegularBlockStaminaLossOnHit = ini.GetBoolValue("Combat", "bEnableRegularBlockStaminaLossOnHit", true);
-        regularBlockStaminaMult = static_cast<float>(ini.GetDoubleValue("Combat", "fRegularBlockStaminaMult", 0.5));
-
-        // [Exhaustion]
-        enableExhaustionDebuff = ini.GetBoolValue("Exhaustion", "bEnableExhaustionDebuff", true);
-        exhaustionStaminaThreshold = static_cast<float>(ini.GetDoubleValue("Exhaustion", "fExhaustionStaminaThreshold", 20.0));
-        exhaustionMovementSpeedDebuff = static_cast<float>(ini.GetDoubleValue("Exhaustion", "fExhaustionMovementSpeedDebuff", 0.20));
-        exhaustionAttackDamageDebuff = static_cast<float>(ini.GetDoubleValue("Exhaustion", "fExhaustionAttackDamageDebuff", 0.25));
-
-        // [TimedBlocking]
-        enableTimedBlocking = ini.GetBoolValue("TimedBlocking", "bEnableTimedBlocking", true);
-        enableTimedBlockSkillRequirement = ini.GetBoolValue("TimedBlocking", "bEnableTimedBlockSkillRequirement", false);
-        timedBlockRequiredSkillLevel = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockRequiredSkillLevel", 0.0));
-        timedBlockWindow1 = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockWindow1", 0.3));
-        timedBlockWindow2 = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockWindow2", 0.25));
-        timedBlockWindow3 = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockWindow3", 0.2));
-        timedBlockWindow4 = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockWindow4", 0.15));
-        timedBlockWindow5 = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockWindow5", 0.1));
-        timedBlockAnimationDelay = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockAnimationDelay", 0.05));
-        blockButton = static_cast<uint32_t>(ini.GetLongValue("TimedBlocking", "iBlockButton", 257));
-        timedBlockStaminaLoss = ini.GetBoolValue("TimedBlocking", "bTimedBlockStaminaLoss", false);
-        timedBlockStaminaGain = ini.GetBoolValue("TimedBlocking", "bTimedBlockStaminaGain", true);
-        timedBlockStaminaAmountGain = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockStaminaAmountGain", 20.0));
-        timedBlockStaminaAmountLossMult = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockStaminaAmountLossMult", 0.5));
-        timedBlockDamageReduction = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fTimedBlockDamageReduction", 1.0));
-        slowTimeOnlyOnPerfectParry = ini.GetBoolValue("TimedBlocking", "bSlowTimeOnlyOnPerfectParry", true);
-        slowTimeDuration = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fSlowTimeDuration", 0.5));
-        slowTimePercentage = static_cast<float>(ini.GetDoubleValue("TimedBlocking", "fSlowTimePercentage", 0.4));
-
-        // [ParrySystem]
-        enableParryStagger = ini.GetBoolValue("ParrySystem", "bEnableParryStagger", true);
-        enablePerfectParry = ini.GetBoolValue("ParrySystem", "bEnablePerfectParry", true);
-        parrySequenceTimeoutBase = static_cast<float>(ini.GetDoubleValue("ParrySystem", "fParrySequenceTimeoutBase", 2.0));
-        parryStaggerMagnitude1 = static_cast<float>(ini.GetDoubleValue("ParrySystem", "fParryStaggerMagnitude1", 0.1));
-        parryStaggerMagnitude2 = static_cast<float>(ini.GetDoubleValue("ParrySystem", "fParryStaggerMagnitude2", 0.2));
-        parryStaggerMagnitude3 = static_cast<float>(ini.GetDoubleValue("ParrySystem", "fParryStaggerMagnitude3", 0.3));
-        parryStaggerMagnitude4 = static_cast<float>(ini.GetDoubleValue("ParrySystem", "fParryStaggerMagnitude4", 0.4));
-        perfectParryStaggerMagnitude = static_cast<float>(ini.GetDoubleValue("ParrySystem", "fPerfectParryStaggerMagnitude", 10.0));
-        parrySoundVolume = static_cast<float>(ini.GetDoubleValue("ParrySystem", "fParrySoundVolume", 1.0));
-        enableParrySparks = ini.GetBoolValue("ParrySystem", "bEnableParrySparks", true);
-
-        // [EldenCounter]
-        enableEldenCounter = ini.GetBoolValue("EldenCounter", "bEnableEldenCounter", false);
-        eldenCounterOnlyTimedBlocks = ini.GetBoolValue("EldenCounter", "bEldenCounterOnlyTimedBlocks", true);
-        eldenCounterOnlyPerfectParry = ini.GetBoolValue("EldenCounter", "bEldenCounterOnlyPerfectParry", false);
-
-        // [NPCs]
-        applyToNPCs = ini.GetBoolValue("NPCs", "bApplyToNPCs", true);
-
-        // [Debug]
-        logLevel = static_cast<int>(ini.GetLongValue("Debug", "iLogLevel", 1));
-
-        logger::info("Configuration loaded successfully");
+        // Single pass over the schema - missing keys fall back to their defaults
+        for (const auto& setting : kSettings) {
+            std::visit([&](auto member) { Read(ini, setting, this->*member); }, setting.member);
+        }
+        ComputeDerived();
+
+        logger::info("Configuration loaded successfully ({} settings)", kSettings.size());
     }
 
     void Config::Save() {
         CSimpleIniA ini;
         ini.SetUnicode();
-
-        ini.SetBoolValue("Stamina", "bEnableStaminaManagement", enableStaminaManagement);
-        ini.SetBoolValue("Stamina", "bEnableJumpStaminaCost", enableJumpStaminaCost);
-        ini.SetDoubleValue("Stamina", "fJumpStaminaCost", jumpStaminaCost);
-        ini.SetBoolValue("Stamina", "bEnableBlockStaminaDrain", enableBlockStaminaDrain);
-        ini.SetDoubleValue("Stamina", "fBlockHoldStaminaCostPerSecond", blockHoldStaminaCostPerSecond);
-        ini.SetBoolValue("Stamina", "bEnableLightAttackStamina", enableLightAttackStamina);
-        ini.SetDoubleValue("Stamina", "fLightAttackStaminaCost", lightAttackStaminaCostMult);
-        ini.SetBoolValue("Stamina", "bEnableRangedStaminaCost", enableRangedStaminaCost);
-        ini.SetBoolValue("Stamina", "bEnableRangedHoldStaminaDrain", enableRangedHoldStaminaDrain);
-        ini.SetDoubleValue("Stamina", "fRangedHoldStaminaCostPerSecond", rangedHoldStaminaCostPerSecond);
-        ini.SetBoolValue("Stamina", "bEnableRangedReleaseStaminaCost", enableRangedReleaseStaminaCost);
-        ini.SetDoubleValue("Stamina", "fRangedReleaseStaminaCost", rangedReleaseStaminaCost);
-        ini.SetBoolValue("Stamina", "bEnableRapidComboStaminaCost", enableRapidComboStaminaCost);
-        ini.SetDoubleValue("Stamina", "fRapidComboStaminaCost", rapidComboStaminaCost);
-
-        ini.SetBoolValue("Combat", "bEnableStaminaLossOnHit", enableStaminaLossOnHit);
-        ini.SetDoubleValue("Combat", "fStaminaLossBaseIntercept", staminaLossBaseIntercept);
-        ini.SetDoubleValue("Combat", "fStaminaLossScalingFactor", staminaLossScalingFactor);
-        ini.SetDoubleValue("Combat", "fStaminaLossFlatAddition", staminaLossFlatAddition);
-        ini.SetBoolValue("Combat", "bEnableRegularBlockStaminaLossOnHit", enableRegularBlockStaminaLossOnHit);
-        ini.SetDoubleValue("Combat", "fRegularBlockStaminaMult", regularBlockStaminaMult);
-
-        ini.SetBoolValue("Exhaustion", "bEnableExhaustionDebuff", enableExhaustionDebuff);
-        ini.SetDoubleValue("Exhaustion", "fExhaustionStaminaThreshold", exhaustionStaminaThreshold);
-        ini.SetDoubleValue("Exhaustion", "fExhaustionMovementSpeedDebuff", exhaustionMovementSpeedDebuff);
-        ini.SetDoubleValue("Exhaustion", "fExhaustionAttackDamageDebuff", exhaustionAttackDamageDebuff);
-
-        ini.SetBoolValue("TimedBlocking", "bEnableTimedBlocking", enableTimedBlocking);
-        ini.SetBoolValue("TimedBlocking", "bEnableTimedBlockSkillRequirement", enableTimedBlockSkillRequirement);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockRequiredSkillLevel", timedBlockRequiredSkillLevel);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockWindow1", timedBlockWindow1);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockWindow2", timedBlockWindow2);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockWindow3", timedBlockWindow3);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockWindow4", timedBlockWindow4);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockWindow5", timedBlockWindow5);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockAnimationDelay", timedBlockAnimationDelay);
-        ini.SetLongValue("TimedBlocking", "iBlockButton", blockButton);
-        ini.SetBoolValue("TimedBlocking", "bTimedBlockStaminaLoss", timedBlockStaminaLoss);
-        ini.SetBoolValue("TimedBlocking", "bTimedBlockStaminaGain", timedBlockStaminaGain);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockStaminaAmountGain", timedBlockStaminaAmountGain);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockStaminaAmountLossMult", timedBlockStaminaAmountLossMult);
-        ini.SetDoubleValue("TimedBlocking", "fTimedBlockDamageReduction", timedBlockDamageReduction);
-        ini.SetBoolValue("TimedBlocking", "bSlowTimeOnlyOnPerfectParry", slowTimeOnlyOnPerfectParry);
-        ini.SetDoubleValue("TimedBlocking", "fSlowTimeDuration", slowTimeDuration);
-        ini.SetDoubleValue("TimedBlocking", "fSlowTimePercentage", slowTimePercentage);
-
-
-        ini.SetBoolValue("ParrySystem", "bEnableParryStagger", enableParryStagger);
-        ini.SetBoolValue("ParrySystem", "bEnablePerfectParry", enablePerfectParry);
-        ini.SetDoubleValue("ParrySystem", "fParrySequenceTimeoutBase", parrySequenceTimeoutBase);
-        ini.SetDoubleValue("ParrySystem", "fParryStaggerMagnitude1", parryStaggerMagnitude1);
-        ini.SetDoubleValue("ParrySystem", "fParryStaggerMagnitude2", parryStaggerMagnitude2);
-        ini.SetDoubleValue("ParrySystem", "fParryStaggerMagnitude3", parryStaggerMagnitude3);
-        ini.SetDoubleValue("ParrySystem", "fParryStaggerMagnitude4", parryStaggerMagnitude4);
-        ini.SetDoubleValue("ParrySystem", "fPerfectParryStaggerMagnitude", perfectParryStaggerMagnitude);
-        ini.SetDoubleValue("ParrySystem", "fParrySoundVolume", parrySoundVolume);
-        ini.SetBoolValue("ParrySystem", "bEnableParrySparks", enableParrySparks);
-
-        ini.SetBoolValue("EldenCounter", "bEnableEldenCounter", enableEldenCounter);
-        ini.SetBoolValue("EldenCounter", "bEldenCounterOnlyTimedBlocks", eldenCounterOnlyTimedBlocks);
-        ini.SetBoolValue("EldenCounter", "bEldenCounterOnlyPerfectParry", eldenCounterOnlyPerfectParry);
-
-        ini.SetBoolValue("NPCs", "bApplyToNPCs", applyToNPCs);
-
-        ini.SetLongValue("Debug", "iLogLevel", logLevel);
+        WriteAll(*this, ini);
 
         auto path = GetConfigPath();
         ini.SaveFile(path.string().c_str());
     }
 
-}
\ No newline at end of file
+    std::string Config::Serialize() const {
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        WriteAll(*this, ini);
+
+        std::string text;
+        ini.Save(text);
+        return text;
+    }
+
+}
@@ -1,4 +1,5 @@
 #include "TheLastBreath/Data.h"
+#include "TheLastBreath/ParryLadder.h"
 
 namespace TheLastBreath {
 
@@ -10,7 +11,9 @@ namespace TheLastBreath {
         }
 
         LoadBlockFX(dataHandler);
-        LoadSounds(dataHandler);
+
+        // Parry sounds are owned by the ladder levels
+        ParryLadder::GetSingleton()->Load();
     }
 
     void Data::LoadBlockFX(RE::TESDataHandler* dataHandler) {
@@ -34,32 +37,4 @@ namespace TheLastBreath {
             logger::info("Block FX loaded successfully");
         }
     }
-
-    void Data::LoadSounds(RE::TESDataHandler* dataHandler) {
-        const char* pluginName = "TheLastBreath.esp";
-
-        // Parries 1-4
-        parryWeaponSound1 = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x800, pluginName);
-        parryWeaponSound2 = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x801, pluginName);
-        parryWeaponSound3 = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x802, pluginName);
-        parryWeaponSound4 = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x803, pluginName);
-        parryShieldSound1 = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x804, pluginName);
-        parryShieldSound2 = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x805, pluginName);
-        parryShieldSound3 = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x806, pluginName);
-        parryShieldSound4 = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x807, pluginName);
-
-        // Parry 5 (Perfect Parry)
-        parryWeaponSoundPerfect = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x817, pluginName);
-        parryShieldSoundPerfect = dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(0x818, pluginName);
-
-        if (!parryWeaponSound1 || !parryShieldSound1) {
-            logger::error("Failed to load parry sounds!");
-        }
-        else {
-            logger::info("Parry sounds loaded successfully");
-            if (parryWeaponSoundPerfect && parryShieldSoundPerfect) {
-                logger::info("Perfect parry sounds loaded successfully");
-            }
-        }
-    }
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "TheLastBreath/EquipEventHandler.h"
+#include "TheLastBreath/AttackCostCache.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/Profiler.h"
+
+namespace TheLastBreath {
+
+    RE::BSEventNotifyControl EquipEventHandler::ProcessEvent(
+        const RE::TESEquipEvent* a_event,
+        RE::BSTEventSource<RE::TESEquipEvent>* a_eventSource)
+    {
+        TLB_PROFILE_SCOPE("EquipEventHandler::ProcessEvent");
+        if (!a_event || !a_event->actor) {
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
+        auto formID = a_event->actor->GetFormID();
+
+        EquipmentSnapshot::GetSingleton()->OnEquipChanged(formID);
+
+        // Equipment class changed - re-resolve the profile on next lookup
+        ProfileManager::GetSingleton()->InvalidateActor(formID);
+
+        // Power attack cost depends on the weapon in hand
+        AttackCostCache::GetSingleton()->InvalidateActor(formID);
+
+        logger::trace("Equip change on {:X} ({} {:X})", formID,
+            a_event->equipped ? "equipped" : "unequipped", a_event->baseObject);
+
+        return RE::BSEventNotifyControl::kContinue;
+    }
+
+}
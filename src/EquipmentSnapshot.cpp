@@ -0,0 +1,84 @@
+#include "TheLastBreath/EquipmentSnapshot.h"
+#include "TheLastBreath/FormClassCache.h"
+
+namespace TheLastBreath {
+
+    Equipment EquipmentSnapshot::Capture(RE::Actor* actor) {
+        Equipment equipment;
+        auto formClasses = FormClassCache::GetSingleton();
+
+        if (auto right = actor->GetEquippedObject(false)) {
+            equipment.right = right->GetFormID();
+
+            auto formClass = formClasses->Classify(right);
+            if (FormClassCache::IsWeapon(formClass)) {
+                equipment.flags |= kEquipRightWeapon;
+            }
+            if (formClass == FormClass::RangedWeapon) {
+                equipment.flags |= kEquipRanged;
+            }
+        }
+
+        if (auto left = actor->GetEquippedObject(true)) {
+            equipment.left = left->GetFormID();
+
+            if (left->IsArmor()) {
+                equipment.flags |= kEquipLeftArmor;
+            }
+            else if (FormClassCache::IsWeapon(formClasses->Classify(left))) {
+                equipment.flags |= kEquipLeftWeapon;
+            }
+        }
+
+        return equipment;
+    }
+
+    Equipment EquipmentSnapshot::Get(RE::Actor* actor) {
+        if (!actor) return {};
+
+        auto formID = actor->GetFormID();
+        auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& entry = entries[SlotOf(formID)];
+
+        if (entry.formID != formID) {
+            entry = { formID };
+        }
+
+        if (!entry.captured || now < entry.volatileUntil) {
+            entry.equipment = Capture(actor);
+            entry.captured = true;
+        }
+
+        return entry.equipment;
+    }
+
+    bool EquipmentSnapshot::IsSettled(RE::FormID formID) {
+        auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto& entry = entries[SlotOf(formID)];
+        return entry.formID != formID || now >= entry.volatileUntil;
+    }
+
+    void EquipmentSnapshot::OnEquipChanged(RE::FormID formID) {
+        auto until = std::chrono::steady_clock::now() + kSettleTime;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Claims the slot even for an actor nothing asked about yet, so its first lookup
+        // after the event is still re-read until the hands settle
+        auto& entry = entries[SlotOf(formID)];
+        if (entry.formID != formID) {
+            entry = { formID };
+        }
+        entry.volatileUntil = until;
+    }
+
+    void EquipmentSnapshot::ClearAll() {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.fill({});
+    }
+
+}
@@ -1,15 +1,38 @@
 #include "TheLastBreath/ExhaustionHandler.h"
+#include "TheLastBreath/ActorValueCache.h"
 #include "TheLastBreath/Config.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/Telemetry.h"
+#include "TheLastBreath/StateExport.h"
 
 namespace TheLastBreath {
 
+    namespace {
+        // Actor values are only written on the main thread - the update worker queues the change
+        void QueueDebuffDeltas(RE::Actor* actor, float speedDelta, float attackDelta) {
+            SKSE::GetTaskInterface()->AddTask([handle = actor->CreateRefHandle(), speedDelta, attackDelta]() {
+                auto ref = handle.get();
+                auto target = ref ? ref->As<RE::Actor>() : nullptr;
+                if (!target) return;
+
+                auto avOwner = target->AsActorValueOwner();
+                avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kSpeedMult, speedDelta);
+                avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kAttackDamageMult, attackDelta);
+                ActorValueCache::GetSingleton()->MarkDirty(target->GetFormID());
+            });
+        }
+    }
+
     void ExhaustionHandler::Update() {
+        TLB_PROFILE_SCOPE("ExhaustionHandler::Update");
         auto config = Config::GetSingleton();
         if (!config->enableStaminaManagement) {
             std::lock_guard<std::mutex> lock(statesMutex);
             if (!actorStates.empty()) {
                 ClearAll();
             }
+            Metrics::GetSingleton()->SetGauge(Gauge::ExhaustedActors, 0);
             return;
         }
 
@@ -24,7 +47,7 @@ namespace TheLastBreath {
         auto [it, inserted] = actorStates.try_emplace(formID);
         auto& state = it->second;
 
-        float currentStamina = player->AsActorValueOwner()->GetActorValue(RE::ActorValue::kStamina);
+        float currentStamina = ActorValueCache::GetSingleton()->Get(player, CachedValue::Stamina);
 
         // Handle exhaustion debuffs
         if (config->enableExhaustionDebuff) {
@@ -43,13 +66,18 @@ namespace TheLastBreath {
                     currentStamina, config->exhaustionStaminaThreshold);
             }
         }
+
+        StateExport::GetSingleton()->SetExhausted(formID, state.isExhausted);
+
+        // Every tracked actor, not just the one updated above
+        auto exhaustedActors = std::ranges::count_if(actorStates, [](const auto& entry) { return entry.second.isExhausted; });
+        Metrics::GetSingleton()->SetGauge(Gauge::ExhaustedActors, static_cast<std::int64_t>(exhaustedActors));
     }
 
     void ExhaustionHandler::ApplyExhaustion(RE::Actor* actor) {
         if (!actor) return;
 
         auto config = Config::GetSingleton();
-        auto avOwner = actor->AsActorValueOwner();
         auto formID = actor->GetFormID();
 
         // NOTE: Mutex already held by caller (Update())
@@ -62,8 +90,9 @@ namespace TheLastBreath {
         auto& state = it->second;
 
         // Store current values BEFORE modification
-        float currentSpeed = avOwner->GetActorValue(RE::ActorValue::kSpeedMult);
-        float currentAttackDamage = avOwner->GetActorValue(RE::ActorValue::kAttackDamageMult);
+        auto avCache = ActorValueCache::GetSingleton();
+        float currentSpeed = avCache->Get(actor, CachedValue::SpeedMult);
+        float currentAttackDamage = avCache->Get(actor, CachedValue::AttackDamageMult);
 
         // Calculate the CHANGE needed (negative = debuff)
         float speedDelta = currentSpeed * -config->exhaustionMovementSpeedDebuff;
@@ -74,17 +103,16 @@ namespace TheLastBreath {
         state.originalAttackDamage = attackDelta;
 
         // Apply using RestoreActorValue (delta-based)
-        avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kSpeedMult, speedDelta);
-        avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kAttackDamageMult, attackDelta);
+        QueueDebuffDeltas(actor, speedDelta, attackDelta);
 
         logger::debug("Applied exhaustion debuffs - Speed delta: {:.1f}, AttackDmg delta: {:.1f}",
             speedDelta, attackDelta);
+        Telemetry::GetSingleton()->RecordExhaustion(actor, true);
     }
 
     void ExhaustionHandler::RemoveExhaustion(RE::Actor* actor) {
         if (!actor) return;
 
-        auto avOwner = actor->AsActorValueOwner();
         auto formID = actor->GetFormID();
 
         // NOTE: Mutex already held by caller (Update() or ClearAll())
@@ -98,11 +126,11 @@ namespace TheLastBreath {
 
         // Restore by reversing the stored deltas
         // Negate the deltas to reverse them
-        avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kSpeedMult, -state.originalSpeed);
-        avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kAttackDamageMult, -state.originalAttackDamage);
+        QueueDebuffDeltas(actor, -state.originalSpeed, -state.originalAttackDamage);
 
         logger::debug("Removed exhaustion debuffs - reversed deltas (Speed: {:.1f}, AttackDmg: {:.1f})",
             -state.originalSpeed, -state.originalAttackDamage);
+        Telemetry::GetSingleton()->RecordExhaustion(actor, false);
     }
 
     void ExhaustionHandler::ClearAll() {
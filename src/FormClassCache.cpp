@@ -0,0 +1,121 @@
+#include "TheLastBreath/FormClassCache.h"
+
+namespace TheLastBreath {
+
+    namespace {
+
+        // Runtime created forms (0xFF index) can be deleted and their ID reused for another type
+        constexpr bool IsCacheable(RE::FormID formID) {
+            return formID != 0 && (formID >> 24) != 0xFF;
+        }
+
+        constexpr std::size_t SlotOf(RE::FormID formID) {
+            return static_cast<std::size_t>((formID * 0x9E3779B1u) >> 20);  // Top 12 bits
+        }
+
+    }
+
+    FormClass FormClassCache::ClassifyForm(const RE::TESForm* form) {
+        if (!form) return FormClass::Other;
+
+        switch (form->GetFormType()) {
+        case RE::FormType::Weapon:
+        {
+            auto type = static_cast<const RE::TESObjectWEAP*>(form)->GetWeaponType();
+            return (type == RE::WEAPON_TYPE::kBow || type == RE::WEAPON_TYPE::kCrossbow) ?
+                FormClass::RangedWeapon : FormClass::MeleeWeapon;
+        }
+        case RE::FormType::Projectile:
+            return FormClass::Projectile;
+        case RE::FormType::Spell:
+        case RE::FormType::Scroll:
+        case RE::FormType::Enchantment:
+            return FormClass::Spell;
+        default:
+            return FormClass::Other;
+        }
+    }
+
+    void FormClassCache::Build() {
+        auto dataHandler = RE::TESDataHandler::GetSingleton();
+        if (!dataHandler || built.load()) return;
+
+        auto add = [&](auto& forms) {
+            for (auto form : forms) {
+                if (form && IsCacheable(form->GetFormID())) {
+                    entries.push_back({ form->GetFormID(), ClassifyForm(form) });
+                }
+            }
+        };
+
+        add(dataHandler->GetFormArray<RE::TESObjectWEAP>());
+        add(dataHandler->GetFormArray<RE::BGSProjectile>());
+        add(dataHandler->GetFormArray<RE::SpellItem>());
+        add(dataHandler->GetFormArray<RE::ScrollItem>());
+        add(dataHandler->GetFormArray<RE::EnchantmentItem>());
+
+        std::ranges::sort(entries, {}, &Entry::formID);
+        built.store(true, std::memory_order_release);
+
+        logger::info("Form class cache built ({} forms)", entries.size());
+    }
+
+    FormClass FormClassCache::FindLate(RE::FormID formID) const {
+        auto slot = SlotOf(formID);
+        for (std::size_t probe = 0; probe < kMaxProbes; ++probe) {
+            auto value = lateEntries[(slot + probe) & (kLateSlots - 1)].load(std::memory_order_acquire);
+            if (value == 0) return FormClass::Unknown;
+            if (static_cast<RE::FormID>(value >> 8) == formID) {
+                return static_cast<FormClass>(value & 0xFF);
+            }
+        }
+        return FormClass::Unknown;
+    }
+
+    void FormClassCache::AddLate(RE::FormID formID, FormClass formClass) {
+        auto packed = (static_cast<std::uint64_t>(formID) << 8) | static_cast<std::uint64_t>(formClass);
+        auto slot = SlotOf(formID);
+
+        for (std::size_t probe = 0; probe < kMaxProbes; ++probe) {
+            auto& entry = lateEntries[(slot + probe) & (kLateSlots - 1)];
+            std::uint64_t expected = 0;
+            if (entry.compare_exchange_strong(expected, packed, std::memory_order_acq_rel)) {
+                return;
+            }
+            // Another thread cached the same form first
+            if (static_cast<RE::FormID>(expected >> 8) == formID) {
+                return;
+            }
+        }
+        // Neighbourhood full - the form is simply classified again next time
+    }
+
+    FormClass FormClassCache::Classify(RE::FormID formID) {
+        if (formID == 0) return FormClass::Other;
+
+        if (IsCacheable(formID)) {
+            if (built.load(std::memory_order_acquire)) {
+                auto it = std::ranges::lower_bound(entries, formID, {}, &Entry::formID);
+                if (it != entries.end() && it->formID == formID) {
+                    return it->formClass;
+                }
+            }
+
+            if (auto formClass = FindLate(formID); formClass != FormClass::Unknown) {
+                return formClass;
+            }
+        }
+
+        auto formClass = ClassifyForm(RE::TESForm::LookupByID(formID));
+        if (IsCacheable(formID)) {
+            AddLate(formID, formClass);
+        }
+        return formClass;
+    }
+
+    FormClass FormClassCache::Classify(const RE::TESForm* form) {
+        // Holding the form already - reading its type is cheaper than searching for its ID
+        return ClassifyForm(form);
+    }
+
+}
@@ -0,0 +1,68 @@
+#include "TheLastBreath/FrameGovernor.h"
+#include "TheLastBreath/Config.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/Offsets.h"
+
+namespace TheLastBreath {
+
+    namespace {
+        // Weight of the newest sample - a few frames of history, so one hitch doesn't shed
+        constexpr float kSmoothing = 0.25f;
+
+        // Baseline weight - sampled about 10 times a second, so it follows the last few seconds
+        constexpr float kBaselineSmoothing = 0.02f;
+
+        void Blend(std::atomic<float>& average, float sample, float smoothing = kSmoothing) {
+            float current = average.load(std::memory_order_relaxed);
+            average.store(current == 0.0f ? sample : current + (sample - current) * smoothing, std::memory_order_relaxed);
+        }
+    }
+
+    void FrameGovernor::Sample() {
+        float delta = Offsets::GetRealTimeDelta();
+        if (delta <= 0.0f) return;
+
+        // Loading screens and pauses report huge deltas that say nothing about combat frame pacing
+        float deltaMs = delta * 1000.0f;
+        if (deltaMs > 250.0f) return;
+
+        Blend(frameTimeMs, deltaMs);
+        Blend(baselineMs, deltaMs, kBaselineSmoothing);
+    }
+
+    void FrameGovernor::RecordCosmeticCost(std::chrono::steady_clock::duration cost) {
+        Blend(cosmeticCostMs, std::chrono::duration<float, std::milli>(cost).count());
+    }
+
+    CosmeticPlan FrameGovernor::Plan() {
+        CosmeticPlan plan;
+
+        auto config = Config::GetSingleton();
+        if (!config->enableFrameGovernor) return plan;
+
+        // Parries run on the main thread - the freshest frame time is right here
+        Sample();
+
+        // The frame this parry lands on pays for the cosmetics on top of the usual frame time
+        float projected = GetFrameTimeMs() + GetCosmeticCostMs();
+
+        // Players who always run below the target are measured against their own frame rate
+        float budget = std::max(config->frameBudgetMs, GetBaselineMs());
+        float scale = budget / config->frameBudgetMs;
+
+        plan.ring = projected < config->derived.shedRingMs * scale;
+        plan.sparks = projected < config->derived.shedSparksMs * scale;
+        if (projected >= config->derived.shortenSlowTimeMs * scale) {
+            plan.slowTimeScale = config->shedSlowTimeMult;
+        }
+
+        if (!plan.ring || !plan.sparks || plan.slowTimeScale < 1.0f) {
+            Metrics::GetSingleton()->Increment(Counter::CosmeticsShed);
+            logger::debug("Frame budget: {:.1f}ms projected / {:.1f}ms budget - ring: {}, sparks: {}, slow time x{:.2f}",
+                projected, budget, plan.ring, plan.sparks, plan.slowTimeScale);
+        }
+
+        return plan;
+    }
+
+}
@@ -0,0 +1,56 @@
+#include "TheLastBreath/FxAnchorPool.h"
+#include "TheLastBreath/Data.h"
+
+namespace TheLastBreath {
+
+    RE::NiPointer<RE::TESObjectREFR> FxAnchorPool::Acquire(RE::Actor* blocker, RE::NiAVObject* node) {
+        if (!blocker || !Data::BlockFX) return nullptr;
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto& handle = anchors[next];
+        next = (next + 1) % kAnchors;
+
+        auto anchor = handle.get();
+        if (anchor && (anchor->IsDeleted() || !anchor->GetParentCell())) {
+            anchor.reset();
+        }
+
+        if (!anchor) {
+            // Created where the blocker stands - the same place the move below would put it
+            anchor = blocker->PlaceObjectAtMe(Data::BlockFX, false);
+            if (!anchor) return nullptr;
+
+            handle = anchor->CreateRefHandle();
+            logger::debug("Created parry FX anchor {:08X}", anchor->GetFormID());
+        } else if (!node) {
+            anchor->MoveTo(blocker);
+        }
+
+        if (node) {
+            anchor->MoveToNode(blocker, node);
+        }
+
+        return anchor;
+    }
+
+    bool FxAnchorPool::PlaceExplosion(RE::TESObjectREFR* anchor, RE::BGSExplosion* explosion) {
+        if (!anchor || !explosion) return false;
+
+        // The explosion reference cleans itself up once it has played
+        return anchor->PlaceObjectAtMe(explosion, false) != nullptr;
+    }
+
+    void FxAnchorPool::ClearAll() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (auto& handle : anchors) {
+            if (auto anchor = handle.get()) {
+                anchor->SetDelete(true);
+            }
+            handle.reset();
+        }
+        next = 0;
+    }
+
+}
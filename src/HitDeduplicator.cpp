@@ -0,0 +1,65 @@
+#include "TheLastBreath/HitDeduplicator.h"
+#include "TheLastBreath/Config.h"
+
+namespace TheLastBreath {
+
+    namespace {
+
+        constexpr std::uint64_t Mix(std::uint64_t hash, std::uint64_t value) {
+            hash ^= value;
+            return hash * 0x100000001B3ull;  // FNV-1a prime
+        }
+
+        constexpr std::uint64_t MakeKey(RE::FormID aggressor, RE::FormID source, RE::FormID projectile, std::uint8_t flags) {
+            std::uint64_t key = 0xCBF29CE484222325ull;
+            key = Mix(key, aggressor);
+            key = Mix(key, source);
+            key = Mix(key, projectile);
+            key = Mix(key, flags);
+            return key != 0 ? key : 1;
+        }
+
+    }
+
+    HitDeduplicator::Ring& HitDeduplicator::Acquire(RE::FormID victim) {
+        // NOTE: Mutex already held by caller
+        if (auto it = std::ranges::find(rings, victim, &Ring::victim); it != rings.end()) {
+            return *it;
+        }
+
+        // Free rings were never hit, so they go first
+        auto& ring = *std::ranges::min_element(rings, {}, &Ring::lastHit);
+        ring = {};
+        ring.victim = victim;
+        return ring;
+    }
+
+    bool HitDeduplicator::IsDuplicate(RE::FormID victim, RE::FormID aggressor, RE::FormID source, RE::FormID projectile,
+        std::uint8_t flags, std::uint64_t frame) {
+        auto maxAge = Config::GetSingleton()->derived.hitDeduplicationWindow;
+
+        auto now = std::chrono::steady_clock::now();
+        auto key = MakeKey(aggressor, source, projectile, flags);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& ring = Acquire(victim);
+        ring.lastHit = now;
+
+        for (const auto& entry : ring.entries) {
+            if (entry.key == key && (entry.frame == frame || now - entry.time < maxAge)) {
+                return true;
+            }
+        }
+
+        // Oldest slot is overwritten - a ring this size holds every distinct hit inside the window
+        ring.entries[ring.next] = { key, frame, now };
+        ring.next = (ring.next + 1) % kRingSize;
+        return false;
+    }
+
+    void HitDeduplicator::ClearAll() {
+        std::lock_guard<std::mutex> lock(mutex);
+        rings.fill({});
+    }
+
+}
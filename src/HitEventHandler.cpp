@@ -2,6 +2,13 @@
 #include "TheLastBreath/CombatHandler.h"
 #include "TheLastBreath/TimedBlockHandler.h"
 #include "TheLastBreath/Config.h"
+#include "TheLastBreath/FormClassCache.h"
+#include "TheLastBreath/HitDeduplicator.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/Offsets.h"
+#include "TheLastBreath/ParryLatency.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/SessionRecorder.h"
 
 namespace TheLastBreath {
 
@@ -9,10 +16,13 @@ namespace TheLastBreath {
         const RE::TESHitEvent* a_event,
         RE::BSTEventSource<RE::TESHitEvent>* a_eventSource)
     {
+        TLB_PROFILE_SCOPE("HitEventHandler::ProcessEvent");
         if (!a_event) {
             return RE::BSEventNotifyControl::kContinue;
         }
 
+        Metrics::ScopedTimer timer(Histogram::HitEvent);
+
         auto victim = a_event->target.get();
         auto aggressor = a_event->cause.get();
 
@@ -33,36 +43,44 @@ namespace TheLastBreath {
         }
 
         // FILTER: Only weapon/projectile hits, NO spells
-        bool isWeaponHit = false;
+        auto formClasses = FormClassCache::GetSingleton();
+        bool isWeaponHit = FormClassCache::IsWeapon(formClasses->Classify(a_event->source)) ||
+            formClasses->Classify(a_event->projectile) == FormClass::Projectile;
 
-        if (a_event->source != 0) {
-            auto sourceForm = RE::TESForm::LookupByID(a_event->source);
-            if (sourceForm && sourceForm->Is(RE::FormType::Weapon)) {
-                isWeaponHit = true;
-            }
+        if (!isWeaponHit) {
+            logger::debug("Ignoring non-weapon hit (likely spell)");
+            return RE::BSEventNotifyControl::kContinue;
         }
 
-        if (!isWeaponHit && a_event->projectile != 0) {
-            auto projectileForm = RE::TESForm::LookupByID(a_event->projectile);
-            if (projectileForm && projectileForm->Is(RE::FormType::Projectile)) {
-                isWeaponHit = true;
-            }
+        // One strike on screen can arrive as several events in the same frame - only the first one counts.
+        // The key only uses the event's own fields: events queued in one frame all see the same lastHitData.
+        if (HitDeduplicator::GetSingleton()->IsDuplicate(victimActor->GetFormID(), aggressorActor->GetFormID(),
+                a_event->source, a_event->projectile, a_event->flags.underlying(), Offsets::GetFrameStamp())) {
+            Metrics::GetSingleton()->Increment(Counter::DuplicateHits);
+            logger::debug("Ignoring duplicate hit from {}", aggressorActor->GetName());
+            return RE::BSEventNotifyControl::kContinue;
         }
 
-        if (!isWeaponHit) {
-            logger::debug("Ignoring non-weapon hit (likely spell)");
-            return RE::BSEventNotifyControl::kContinue;
+        Metrics::GetSingleton()->Increment(Counter::HitEvents);
+
+        // Damage the strike did, from the victim's last HitData
+        RE::HitData* lastHitData = nullptr;
+        auto currentProcess = victimActor->GetActorRuntimeData().currentProcess;
+        if (currentProcess && currentProcess->middleHigh) {
+            lastHitData = currentProcess->middleHigh->lastHitData;
         }
 
         bool wasBlocked = a_event->flags.all(RE::TESHitEvent::Flag::kHitBlocked);
 
         // Determine block type
         BlockType blockType = BlockType::None;
+        float window = 0.0f;
         if (wasBlocked) {
             auto timedBlockHandler = TheLastBreath::TimedBlockHandler::GetSingleton();
-            blockType = timedBlockHandler->CheckBlockType(victimActor);
+            blockType = timedBlockHandler->CheckBlockType(victimActor, &window);
 
             if (blockType == BlockType::Timed) {
+                ParryLatency::GetSingleton()->Checkpoint(victimActor, ParryStage::HitConfirmed);
                 timedBlockHandler->ConsumeTimedBlock(victimActor);
             }
         }
@@ -72,17 +90,13 @@ namespace TheLastBreath {
         // ============================================
         float actualDamageTaken = 0.0f;
 
-        auto currentProcess = victimActor->GetActorRuntimeData().currentProcess;
-        if (currentProcess && currentProcess->middleHigh) {
-            auto lastHitData = currentProcess->middleHigh->lastHitData;
-            if (lastHitData) {
-                actualDamageTaken = lastHitData->totalDamage;
-
-                logger::debug("Actual damage from lastHitData: {:.2f} (physical: {:.2f}, blocked: {:.1f}%)",
-                    actualDamageTaken,
-                    lastHitData->physicalDamage,
-                    lastHitData->percentBlocked * 100.0f);
-            }
+        if (lastHitData) {
+            actualDamageTaken = lastHitData->totalDamage;
+
+            logger::debug("Actual damage from lastHitData: {:.2f} (physical: {:.2f}, blocked: {:.1f}%)",
+                actualDamageTaken,
+                lastHitData->physicalDamage,
+                lastHitData->percentBlocked * 100.0f);
         }
 
         logger::debug("Player hit by {} (block type: {}, damage: {:.2f})",
@@ -91,6 +105,17 @@ namespace TheLastBreath {
             blockType == BlockType::Regular ? "REGULAR" : "NONE",
             actualDamageTaken);
 
+        std::uint8_t recordFlags = (wasBlocked ? SessionLog::kHitBlocked : 0) |
+            (a_event->projectile != 0 ? SessionLog::kHitProjectile : 0);
+        SessionRecorder::GetSingleton()->RecordHit(victimActor, aggressorActor, actualDamageTaken, recordFlags, blockType, window);
+
+        // Arrows and bolts are deflected, not parried - nobody at range gets staggered
+        if (blockType == BlockType::Timed && a_event->projectile != 0 && Config::GetSingleton()->enableProjectileParry) {
+            CombatHandler::GetSingleton()->OnProjectileParried(victimActor, aggressorActor, actualDamageTaken,
+                lastHitData ? lastHitData->sourceRef : RE::ObjectRefHandle());
+            return RE::BSEventNotifyControl::kContinue;
+        }
+
         // Pass actual damage to combat handler
         CombatHandler::GetSingleton()->OnActorHit(victimActor, aggressorActor, actualDamageTaken, blockType);
 
@@ -1,6 +1,7 @@
 #include "TheLastBreath/HitProcessor.h"
 #include "TheLastBreath/Config.h"
 #include "TheLastBreath/TimedBlockHandler.h"
+#include "TheLastBreath/ParryLatency.h"
 
 namespace TheLastBreath {
 
@@ -16,6 +17,7 @@ namespace TheLastBreath {
         // Check if this is a valid timed block
         if (IsValidTimedBlock(victim, aggressor, hitData)) {
             logger::info("=== TIMED BLOCK DETECTED (Hit Processor) ===");
+            ParryLatency::GetSingleton()->Checkpoint(victim, ParryStage::HookDecision);
 
             // Apply damage reduction to hit data BEFORE damage is calculated
             ApplyTimedBlockDamageReduction(hitData);
@@ -55,16 +57,23 @@ namespace TheLastBreath {
         return true;
     }
 
+    void HitProcessor::DestroyProjectile(RE::ObjectRefHandle projectile) {
+        if (!projectile || !Config::GetSingleton()->destroyParriedProjectiles) return;
+
+        // Not while the engine is still resolving its impact
+        SKSE::GetTaskInterface()->AddTask([projectile]() {
+            if (auto ref = projectile.get()) {
+                ref->Disable();
+            }
+        });
+    }
+
     void HitProcessor::ApplyTimedBlockDamageReduction(RE::HitData& hitData) {
         auto config = Config::GetSingleton();
 
-        // Get the damage reduction multiplier (0.0 to 1.0)
+        // Get the damage reduction multiplier (0.0 to 1.0, range enforced by the config schema)
         float reductionMultiplier = config->timedBlockDamageReduction;
 
-        // Clamp to valid range
-        if (reductionMultiplier < 0.0f) reductionMultiplier = 0.0f;
-        if (reductionMultiplier > 1.0f) reductionMultiplier = 1.0f;
-
         // Use percentBlocked to modify damage naturally
         // percentBlocked of 1.0 = 100% blocked = no damage
         // percentBlocked of 0.5 = 50% blocked = half damage
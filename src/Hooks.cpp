@@ -1,7 +1,13 @@
 ﻿#include "TheLastBreath/Hooks.h"
+#include "TheLastBreath/AttackCostCache.h"
+#include "TheLastBreath/AttackCostModel.h"
 #include "TheLastBreath/Config.h"
 #include "TheLastBreath/HitProcessor.h"
 #include "TheLastBreath/EldenCounterCompat.h"
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/Telemetry.h"
 
 namespace TheLastBreath {
     namespace Hooks {
@@ -10,19 +16,26 @@ namespace TheLastBreath {
         // ATTACK STAMINA COST HOOK
         // ============================================
 
-        // Recursion guard
-        static thread_local bool g_inCalculation = false;
+        // Call-site hook: the original target is a plain call
+        static inline REL::Relocation<float(RE::ActorValueOwner*, RE::BGSAttackData*)> _GetAttackStaminaCost;
 
-        static float GetAttackStaminaCost(RE::ActorValueOwner* avOwner, RE::BGSAttackData* attackData);
-        static inline REL::Relocation<decltype(GetAttackStaminaCost)> _GetAttackStaminaCost;
-
-        // Helper function to calculate power attack cost
+        // Helper function to calculate power attack cost.
+        // Prefers the closed-form model; the engine fallback calls the original directly,
+        // so it never re-enters the hooked call site.
         static float CalculatePowerAttackCost(RE::Actor* actor, RE::BGSAttackData* attackData) {
             if (!actor || !attackData) {
                 return 35.0f;
             }
 
-            g_inCalculation = true;
+            if (auto modelCost = AttackCostModel::GetSingleton()->PowerAttackCost(actor, attackData)) {
+                logger::debug("Calculated current power attack cost: {} (closed form)", *modelCost);
+                return *modelCost > 0.0f ? *modelCost : 35.0f;
+            }
+
+            auto costCache = AttackCostCache::GetSingleton();
+            if (auto cachedCost = costCache->Find(actor, attackData)) {
+                return *cachedCost;
+            }
 
             bool wasPowerAttack = attackData->data.flags.any(RE::AttackData::AttackFlag::kPowerAttack);
             attackData->data.flags.set(RE::AttackData::AttackFlag::kPowerAttack);
@@ -33,25 +46,20 @@ namespace TheLastBreath {
                 attackData->data.flags.reset(RE::AttackData::AttackFlag::kPowerAttack);
             }
 
-            g_inCalculation = false;
-
             logger::debug("Calculated current power attack cost: {}", powerCost);
-            return powerCost > 0.0f ? powerCost : 35.0f;
+            powerCost = powerCost > 0.0f ? powerCost : 35.0f;
+            costCache->Store(actor, attackData, powerCost);
+            return powerCost;
         }
 
+        // Only installed when stamina management and light attack stamina are both
+        // enabled, so the feature flags are not re-checked per call. Light attack cost
+        // applies to every actor regardless of bApplyToNPCs
         static float GetAttackStaminaCost(RE::ActorValueOwner* avOwner, RE::BGSAttackData* attackData) {
+            TLB_PROFILE_SCOPE("Hooks::GetAttackStaminaCost");
+            Metrics::ScopedTimer timer(Histogram::AttackCostHook);
+            Metrics::GetSingleton()->Increment(Counter::AttackCostQueries);
 
-            auto config = Config::GetSingleton();
-
-            if (!config->enableStaminaManagement || !config->enableLightAttackStamina) {
-                return _GetAttackStaminaCost(avOwner, attackData);
-            }
-
-            if (g_inCalculation) {
-                return _GetAttackStaminaCost(avOwner, attackData);
-            }
-
-            // Try to get the actor
             auto actor = skyrim_cast<RE::Actor*>(avOwner);
             if (!actor) {
                 return _GetAttackStaminaCost(avOwner, attackData);
@@ -81,21 +89,21 @@ namespace TheLastBreath {
             // CHECK ATTACK TYPE (Like Valhalla)
             // ============================================
 
-            // If we have attackData, check what type it is
-            if (actualAttackData) {
-                // Bash - return vanilla cost
-                if (actualAttackData->data.flags.any(RE::AttackData::AttackFlag::kBashAttack)) {
-                    float vanillaCost = _GetAttackStaminaCost(avOwner, attackData);
-                    logger::debug("Bash - vanilla cost: {}", vanillaCost);
-                    return vanillaCost;
-                }
+            // Bash and power attacks keep the vanilla cost
+            if (actualAttackData && actualAttackData->data.flags.any(
+                    RE::AttackData::AttackFlag::kBashAttack, RE::AttackData::AttackFlag::kPowerAttack)) {
+                float vanillaCost = _GetAttackStaminaCost(avOwner, attackData);
 
-                // Power Attack - return vanilla cost
-                if (actualAttackData->data.flags.any(RE::AttackData::AttackFlag::kPowerAttack)) {
-                    float vanillaCost = _GetAttackStaminaCost(avOwner, attackData);
-                    logger::debug("Power attack - vanilla cost: {}", vanillaCost);
-                    return vanillaCost;
+                // Only a cost the engine computed for the attack data the branch was decided on says
+                // anything about the model
+                if (actualAttackData == attackData) {
+                    AttackCostModel::GetSingleton()->Validate(actor, actualAttackData, vanillaCost);
                 }
+                Telemetry::GetSingleton()->SetPendingAttackCost(actor, 0.0f);
+                logger::debug("{} - vanilla cost: {}",
+                    actualAttackData->data.flags.any(RE::AttackData::AttackFlag::kBashAttack) ? "Bash" : "Power attack",
+                    vanillaCost);
+                return vanillaCost;
             }
 
             // ============================================
@@ -104,23 +112,31 @@ namespace TheLastBreath {
 
             // Use actualAttackData (from process) for calculation
             float powerAttackCost = CalculatePowerAttackCost(actor, actualAttackData);
-            float lightCost = powerAttackCost * config->lightAttackStaminaCostMult;
+            float lightMult = ProfileManager::GetSingleton()->GetProfile(actor).lightAttackStaminaCostMult;
+            float lightCost = powerAttackCost * lightMult;
 
             logger::debug("Light attack cost: {} ({}% of power: {})",
-                lightCost, config->lightAttackStaminaCostMult * 100.0f, powerAttackCost);
+                lightCost, lightMult * 100.0f, powerAttackCost);
+            Telemetry::GetSingleton()->SetPendingAttackCost(actor, lightCost);
 
             return lightCost;
         }
+
         // ============================================
         // HIT PROCESSING HOOK
         // ============================================
 
-        // Function signature for Character::ProcessHitEvent
-        using ProcessHitEvent_t = void(RE::Character*, RE::HitData&);
-        static inline REL::Relocation<ProcessHitEvent_t> _ProcessHitEvent;
+        // Call-site hook (Valhalla/Elden Parry's OnMeleeHit): the original target is a plain
+        // call, so there are no overwritten prologue bytes to replay
+        using ProcessHit_t = void(RE::Actor*, RE::HitData&);
+        static inline REL::Relocation<ProcessHit_t> _ProcessHit;
+
+        static void ProcessHitHook(RE::Actor* a_victim, RE::HitData& a_hitData) {
+            TLB_PROFILE_SCOPE("Hooks::ProcessHitHook");
+            Metrics::ScopedTimer timer(Histogram::ProcessHitHook);
+            Metrics::GetSingleton()->Increment(Counter::PreDamageHits);
 
-        static void ProcessHitEventHook(RE::Character* a_this, RE::HitData& a_hitData) {
-            logger::trace("ProcessHitEventHook: Called for {}", a_this ? a_this->GetName() : "nullptr");
+            logger::trace("ProcessHitHook: Called for {}", a_victim ? a_victim->GetName() : "nullptr");
 
             // Get aggressor from hitData
             RE::Actor* aggressor = nullptr;
@@ -129,54 +145,57 @@ namespace TheLastBreath {
             }
 
             // Process through HitProcessor BEFORE damage calculation
-            if (aggressor && a_this) {
-                // Cast Character to Actor (Character inherits from Actor, so this is safe)
-                auto victim = static_cast<RE::Actor*>(a_this);
-
-                logger::trace("ProcessHitEventHook: Calling HitProcessor");
-                HitProcessor::GetSingleton()->ProcessHit(aggressor, victim, a_hitData);
+            if (aggressor && a_victim) {
+                logger::trace("ProcessHitHook: Calling HitProcessor");
+                HitProcessor::GetSingleton()->ProcessHit(aggressor, a_victim, a_hitData);
             }
 
             // Call original function (damage gets calculated with modified hitData)
-            _ProcessHitEvent(a_this, a_hitData);
+            _ProcessHit(a_victim, a_hitData);
         }
         // ============================================
         // INSTALL FUNCTIONS
         // ============================================
 
         void Install() {
-            logger::info("Installing attack stamina cost hook...");
+            auto config = Config::GetSingleton();
 
             // Allocate MORE trampoline space since we're installing multiple hooks
             SKSE::AllocTrampoline(128);  // Increased from 64 to 128
 
-            auto& trampoline = SKSE::GetTrampoline();
-            REL::Relocation<uintptr_t> hook{ RELOCATION_ID(37650, 38603) };
+            if (config->enableStaminaManagement && config->enableLightAttackStamina) {
+                logger::info("Installing attack stamina cost hook...");
 
-            std::uintptr_t offset = REL::Module::IsAE() ? 0x171 : 0x16E;
+                auto& trampoline = SKSE::GetTrampoline();
+                REL::Relocation<uintptr_t> hook{ RELOCATION_ID(37650, 38603) };
 
-            _GetAttackStaminaCost = trampoline.write_call<5>(hook.address() + offset, GetAttackStaminaCost);
+                std::uintptr_t offset = REL::Module::IsAE() ? 0x171 : 0x16E;
 
-            logger::info("Attack stamina cost hook installed");
+                _GetAttackStaminaCost = trampoline.write_call<5>(hook.address() + offset, GetAttackStaminaCost);
+
+                logger::info("Attack stamina cost hook installed");
+            }
+            else {
+                logger::info("Light attack stamina disabled - attack stamina cost hook not installed");
+            }
+
+            if (config->usePreDamageHook && config->enableTimedBlocking) {
+                InstallHitHook();
+            }
         }
 
         void InstallHitHook() {
             logger::info("Installing hit processing hook...");
 
-            // Hook Character::ProcessHitEvent directly using detour
-            // SE: 37673, AE: 38626
-            REL::Relocation<std::uintptr_t> ProcessHitEventAddr{ RELOCATION_ID(37673, 38626) };
-
-            logger::info("ProcessHitEvent function address: {:X}", ProcessHitEventAddr.address());
+            // The hit processing call inside the melee hit handler
+            // SE: 37673 + 0x3C0, AE: 38627 + 0x4A8
+            REL::Relocation<std::uintptr_t> hook{ RELOCATION_ID(37673, 38627) };
+            std::uintptr_t offset = REL::Module::IsAE() ? 0x4A8 : 0x3C0;
 
-            // Use trampoline to detour the function
             auto& trampoline = SKSE::GetTrampoline();
-            _ProcessHitEvent = trampoline.write_branch<5>(
-                ProcessHitEventAddr.address(),
-                reinterpret_cast<std::uintptr_t>(ProcessHitEventHook)
-            );
+            _ProcessHit = trampoline.write_call<5>(hook.address() + offset, ProcessHitHook);
 
-            logger::info("Hit processing hook installed via function detour");
+            logger::info("Hit processing hook installed");
         }
 
     }
@@ -1,14 +1,32 @@
 ﻿#include <SKSE/SKSE.h>
+#include "TheLastBreath/ActorValueCache.h"
 #include "TheLastBreath/AnimationHandler.h"
+#include "TheLastBreath/AttackCostCache.h"
+#include "TheLastBreath/AttackCostModel.h"
 #include "TheLastBreath/CombatEventHandler.h"
 #include "TheLastBreath/Config.h"
 #include "TheLastBreath/Hooks.h"
+#include "TheLastBreath/Metrics.h"
 #include "TheLastBreath/RangedStaminaHandler.h"
 #include "TheLastBreath/ExhaustionHandler.h"
 #include "TheLastBreath/HitEventHandler.h"
 #include "TheLastBreath/CombatHandler.h"
 #include "TheLastBreath/Data.h"
 #include "TheLastBreath/EldenCounterCompat.h"
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/EquipEventHandler.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+#include "TheLastBreath/FrameGovernor.h"
+#include "TheLastBreath/FxAnchorPool.h"
+#include "TheLastBreath/FormClassCache.h"
+#include "TheLastBreath/HitDeduplicator.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/ParryLatency.h"
+#include "TheLastBreath/SessionRecorder.h"
+#include "TheLastBreath/StaminaLedger.h"
+#include "TheLastBreath/Telemetry.h"
+#include "TheLastBreath/StateExport.h"
+#include "TheLastBreath/WeaponStatsCache.h"
 #include <atomic>
 #include <thread>
 
@@ -54,10 +72,23 @@ namespace {
 
         g_updateWorker = std::thread([]() {
             while (g_updateWorkerRunning.load(std::memory_order_relaxed)) {
-                TheLastBreath::RangedStaminaHandler::GetSingleton()->Update();
-                TheLastBreath::ExhaustionHandler::GetSingleton()->Update();
-                TheLastBreath::TimedBlockHandler::GetSingleton()->Update();
-                TheLastBreath::CombatHandler::GetSingleton()->Update();
+                {
+                    TheLastBreath::Metrics::ScopedTimer timer(TheLastBreath::Histogram::UpdatePass);
+                    TheLastBreath::StateExport::GetSingleton()->BeginPass();
+                    TheLastBreath::ActorValueCache::GetSingleton()->BeginPass();
+                    TheLastBreath::RangedStaminaHandler::GetSingleton()->Update();
+                    TheLastBreath::ExhaustionHandler::GetSingleton()->Update();
+                    TheLastBreath::TimedBlockHandler::GetSingleton()->Update();
+                    TheLastBreath::CombatHandler::GetSingleton()->Update();
+                    TheLastBreath::StateExport::GetSingleton()->Publish();
+                }
+                TheLastBreath::FrameGovernor::GetSingleton()->Sample();
+                TheLastBreath::Metrics::GetSingleton()->Tick();
+                TheLastBreath::SessionRecorder::GetSingleton()->Tick();
+                TheLastBreath::Telemetry::GetSingleton()->Tick();
+#ifdef TLB_ENABLE_PROFILER
+                TheLastBreath::Profiler::GetSingleton()->Tick();
+#endif
                 std::this_thread::sleep_for(100ms);
             }
             });
@@ -67,6 +98,15 @@ namespace {
     {
         if (!g_updateWorkerRunning.exchange(false)) return;
         if (g_updateWorker.joinable()) g_updateWorker.join();
+
+        TheLastBreath::SessionRecorder::GetSingleton()->Stop();
+        TheLastBreath::Telemetry::GetSingleton()->Flush();
+        TheLastBreath::StaminaLedger::GetSingleton()->LogTotals();
+
+        // Keep the stats of the session that just ended
+        if (TheLastBreath::Metrics::GetSingleton()->IsEnabled()) {
+            TheLastBreath::Metrics::GetSingleton()->Flush();
+        }
     }
 
     class InputEventHandler : public RE::BSTEventSink<RE::InputEvent*> {
@@ -78,43 +118,15 @@ namespace {
 
         // Helper function to check if player can block (has weapon or shield)
         static bool CanPlayerBlock(RE::PlayerCharacter* player) {
-            if (!player) return false;
-
-            // Check right hand (weapon slot)
-            auto rightHand = player->GetEquippedObject(false);
-            if (rightHand) {
-                auto weapon = rightHand->As<RE::TESObjectWEAP>();
-                if (weapon) {
-                    // Player has a weapon equipped - can block
-                    return true;
-                }
-            }
-
-            // Check left hand (shield/weapon slot)
-            auto leftHand = player->GetEquippedObject(true);
-            if (leftHand) {
-                // Check if it's armor (shield)
-                auto armor = leftHand->As<RE::TESObjectARMO>();
-                if (armor) {
-                    // Shields are armor, so if we have armor equipped in left hand, it's a shield
-                    return true;
-                }
-                // Check if it's a weapon (dual wielding)
-                auto weapon = leftHand->As<RE::TESObjectWEAP>();
-                if (weapon) {
-                    // Player has a weapon in left hand (dual wielding) - can block
-                    return true;
-                }
-            }
-
-            // No weapon or shield equipped - cannot block
-            return false;
+            // Weapon in either hand, or a shield (any armor in the left hand)
+            return player && TheLastBreath::EquipmentSnapshot::GetSingleton()->Get(player).CanBlock();
         }
 
         virtual RE::BSEventNotifyControl ProcessEvent(
             RE::InputEvent* const* a_event,
             RE::BSTEventSource<RE::InputEvent*>* a_eventSource) override
         {
+            TLB_PROFILE_SCOPE("InputEventHandler::ProcessEvent");
             if (!a_event) {
                 return RE::BSEventNotifyControl::kContinue;
             }
@@ -150,6 +162,13 @@ namespace {
                                 continue;
                             }
 
+#ifdef TLB_ENABLE_PROFILER
+                            if (config->profilerHotkey != 0 && keyCode == config->profilerHotkey && buttonEvent->IsDown()) {
+                                TheLastBreath::Profiler::GetSingleton()->ToggleCapture();
+                                continue;
+                            }
+#endif
+
                             // Check if this is our configured block button
                             if (keyCode == config->blockButton) {
                                 if (!CanPlayerBlock(player)) {
@@ -158,6 +177,7 @@ namespace {
 
                                 if (buttonEvent->IsDown() && buttonEvent->value > 0.0f) {
                                     logger::debug("Block button PRESSED (key: {})", keyCode);
+                                    TheLastBreath::ParryLatency::GetSingleton()->Checkpoint(player, TheLastBreath::ParryStage::Press);
                                     TheLastBreath::TimedBlockHandler::GetSingleton()->OnButtonPressed(player);
                                     TheLastBreath::CombatHandler::GetSingleton()->OnBlockStart(player);
                                 }
@@ -237,6 +257,18 @@ namespace {
             // Load all game data (sounds, FX, etc.)
             TheLastBreath::Data::LoadData();
 
+            // Build per weapon/race/keyword profiles (needs forms loaded)
+            TheLastBreath::ProfileManager::GetSingleton()->Compile();
+
+            // Weapon/projectile/spell classification for hit filtering
+            TheLastBreath::FormClassCache::GetSingleton()->Build();
+
+            // Weapon and shield stats for weight-based stamina costs
+            TheLastBreath::WeaponStatsCache::GetSingleton()->Build();
+
+            // Light attack costs are derived from the power attack formula
+            TheLastBreath::AttackCostModel::GetSingleton()->Initialize();
+
             logger::info("Configuration loaded");
 
             // Register event handlers
@@ -254,11 +286,22 @@ namespace {
 
                 scriptEventSource->AddEventSink(TheLastBreath::HitEventHandler::GetSingleton());
                 logger::debug("Hit event handler registered");
+
+                scriptEventSource->AddEventSink(TheLastBreath::EquipEventHandler::GetSingleton());
+                logger::debug("Equip event handler registered");
+
+                scriptEventSource->AddEventSink<RE::TESActiveEffectApplyRemoveEvent>(TheLastBreath::AttackCostCache::GetSingleton());
+                logger::debug("Active effect handler registered for attack cost cache");
             }
             else {
                 logger::error("Failed to get script event source");
             }
 
+            if (auto ui = RE::UI::GetSingleton()) {
+                ui->AddEventSink<RE::MenuOpenCloseEvent>(TheLastBreath::AttackCostCache::GetSingleton());
+                logger::debug("Menu event handler registered for attack cost cache");
+            }
+
             // Initialize Elden Counter compatibility
             TheLastBreath::EldenCounterCompat::GetSingleton()->Initialize();
 
@@ -274,14 +317,43 @@ namespace {
             g_gameLoaded.store(true);
 
             TheLastBreath::ExhaustionHandler::GetSingleton()->ClearAll();
+            TheLastBreath::ProfileManager::GetSingleton()->ClearAll();
+            TheLastBreath::HitDeduplicator::GetSingleton()->ClearAll();
+            TheLastBreath::AttackCostCache::GetSingleton()->ClearAll();
+            TheLastBreath::ActorValueCache::GetSingleton()->ClearAll();
+            TheLastBreath::EquipmentSnapshot::GetSingleton()->ClearAll();
+            TheLastBreath::StaminaLedger::GetSingleton()->ClearAll();
+            TheLastBreath::WeaponStatsCache::GetSingleton()->ClearRuntime();
             logger::debug("Ready - animation events will register on first player input");
 
+            TheLastBreath::StateExport::GetSingleton()->Open();
             StartUpdateWorker();
+            TheLastBreath::SessionRecorder::GetSingleton()->Start();
+
+#ifdef TLB_ENABLE_PROFILER
+            if (TheLastBreath::Config::GetSingleton()->profilerCaptureOnLoad) {
+                TheLastBreath::Profiler::GetSingleton()->StartCapture();
+            }
+#endif
+
+            break;
+        }
 
+        case SKSE::MessagingInterface::kSaveGame:
+        {
+            // Sent before the save is written - anchors must not end up in it
+            TheLastBreath::FxAnchorPool::GetSingleton()->ClearAll();
             break;
         }
 
         case SKSE::MessagingInterface::kPreLoadGame:
+        {
+            // Still the old world, so the anchor handles resolve to our references
+            TheLastBreath::FxAnchorPool::GetSingleton()->ClearAll();
+            StopUpdateWorker();
+            break;
+        }
+
         case SKSE::MessagingInterface::kDeleteGame:
         {
             StopUpdateWorker();
@@ -0,0 +1,141 @@
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/Config.h"
+#include <fstream>
+
+namespace TheLastBreath {
+
+    namespace {
+
+        constexpr std::array<std::string_view, static_cast<std::size_t>(Counter::kCount)> COUNTER_NAMES = {
+            "hit_events", "pre_damage_hits", "timed_blocks", "perfect_parries",
+            "staggers", "block_drain_ticks", "ranged_drain_ticks", "attack_cost_queries",
+            "cosmetics_shed", "duplicate_hits", "projectile_parries"
+        };
+
+        constexpr std::array<std::string_view, static_cast<std::size_t>(Gauge::kCount)> GAUGE_NAMES = {
+            "timed_block_actors", "block_effects_actors", "block_drain_actors",
+            "ranged_drain_actors", "exhausted_actors"
+        };
+
+        constexpr std::array<std::string_view, static_cast<std::size_t>(Histogram::kCount)> HISTOGRAM_NAMES = {
+            "attack_cost_hook_us", "process_hit_hook_us", "hit_event_us", "update_pass_us",
+            "parry_press_to_window_us", "parry_press_to_hook_us", "parry_hook_to_confirm_us",
+            "parry_confirm_to_effects_us", "parry_press_to_effects_us"
+        };
+
+        void AtomicMax(std::atomic<std::uint64_t>& target, std::uint64_t value) {
+            auto current = target.load(std::memory_order_relaxed);
+            while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+    }
+
+    Metrics::Metrics() :
+        startTime(std::chrono::steady_clock::now()),
+        lastFlush(startTime) {
+        enabled.store(Config::GetSingleton()->enableMetrics, std::memory_order_relaxed);
+
+        if (auto path = logger::log_directory()) {
+            statsPath = *path / "TheLastBreath_Stats.txt";
+        }
+    }
+
+    Metrics::Shard& Metrics::LocalShard() {
+        // Threads are spread round robin over the shards the first time they record
+        thread_local std::size_t index = nextShard.fetch_add(1, std::memory_order_relaxed) % kShardCount;
+        return shards[index];
+    }
+
+    void Metrics::RecordParryLevel(std::uint32_t level) {
+        if (!IsEnabled() || level == 0) return;
+        auto index = std::min<std::size_t>(level, kMaxParryLevels) - 1;
+        LocalShard().parryLevels[index].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Metrics::Record(Histogram histogram, std::uint64_t micros) {
+        if (!IsEnabled()) return;
+
+        auto& shard = LocalShard().histograms[static_cast<std::size_t>(histogram)];
+        shard.buckets[HistogramBuckets::IndexOf(micros)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(micros, std::memory_order_relaxed);
+        AtomicMax(shard.max, micros);
+    }
+
+    std::uint64_t Metrics::SumCounter(Counter counter) const {
+        std::uint64_t total = 0;
+        for (const auto& shard : shards) {
+            total += shard.counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    HistogramSnapshot Metrics::Snapshot(Histogram histogram) const {
+        HistogramSnapshot snapshot;
+        for (const auto& shard : shards) {
+            const auto& source = shard.histograms[static_cast<std::size_t>(histogram)];
+            for (std::size_t i = 0; i < HistogramBuckets::kCount; ++i) {
+                auto count = source.buckets[i].load(std::memory_order_relaxed);
+                snapshot.buckets[i] += count;
+                snapshot.count += count;
+            }
+            snapshot.sum += source.sum.load(std::memory_order_relaxed);
+            snapshot.max = std::max(snapshot.max, source.max.load(std::memory_order_relaxed));
+        }
+        return snapshot;
+    }
+
+    void Metrics::Tick() {
+        if (!IsEnabled()) return;
+
+        auto now = std::chrono::steady_clock::now();
+        auto interval = std::chrono::duration<float>(Config::GetSingleton()->metricsFlushInterval);
+        if (now - lastFlush < interval) return;
+
+        lastFlush = now;
+        Flush();
+    }
+
+    void Metrics::Flush() {
+        if (statsPath.empty()) return;
+
+        std::ofstream file(statsPath, std::ios::trunc);
+        if (!file) {
+            logger::warn("Metrics: failed to open {}", statsPath.string());
+            return;
+        }
+
+        auto uptime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - startTime);
+        file << "# TheLastBreath stats - cumulative since plugin load\n";
+        file << "uptime_s " << uptime.count() << '\n';
+
+        for (std::size_t i = 0; i < COUNTER_NAMES.size(); ++i) {
+            file << COUNTER_NAMES[i] << ' ' << SumCounter(static_cast<Counter>(i)) << '\n';
+        }
+
+        for (std::size_t i = 0; i < GAUGE_NAMES.size(); ++i) {
+            file << GAUGE_NAMES[i] << ' ' << gauges[i].load(std::memory_order_relaxed) << '\n';
+        }
+
+        file << "parry_levels";
+        for (std::size_t level = 0; level < kMaxParryLevels; ++level) {
+            std::uint64_t total = 0;
+            for (const auto& shard : shards) {
+                total += shard.parryLevels[level].load(std::memory_order_relaxed);
+            }
+            file << ' ' << total;
+        }
+        file << '\n';
+
+        // name count mean p50 p95 p99 max
+        for (std::size_t i = 0; i < HISTOGRAM_NAMES.size(); ++i) {
+            auto snapshot = Snapshot(static_cast<Histogram>(i));
+            file << HISTOGRAM_NAMES[i] << ' ' << snapshot.count << ' ' << static_cast<std::uint64_t>(snapshot.Mean())
+                 << ' ' << snapshot.Percentile(50.0) << ' ' << snapshot.Percentile(95.0)
+                 << ' ' << snapshot.Percentile(99.0) << ' ' << snapshot.max << '\n';
+        }
+
+        logger::debug("Metrics flushed to {}", statsPath.string());
+    }
+
+}
@@ -0,0 +1,232 @@
+#include "TheLastBreath/ParryChainTable.h"
+
+namespace TheLastBreath {
+
+    template <class KeyOf>
+    const ParryChainTable::Slot* ParryChainTable::Index::Find(std::uint64_t key, KeyOf keyOf) const {
+        for (auto i = Home(key);; i = (i + 1) % kIndexSize) {
+            auto& bucket = buckets[i];
+            if (bucket == 0) return nullptr;
+            if (keyOf(static_cast<Slot>(bucket - 1)) == key) return &bucket;
+        }
+    }
+
+    void ParryChainTable::Index::Insert(std::uint64_t key, Slot slot) {
+        auto i = Home(key);
+        while (buckets[i] != 0) {
+            i = (i + 1) % kIndexSize;
+        }
+        buckets[i] = static_cast<Slot>(slot + 1);
+    }
+
+    template <class KeyOf>
+    void ParryChainTable::Index::Erase(std::uint64_t key, KeyOf keyOf) {
+        auto bucket = Find(key, keyOf);
+        if (!bucket) return;
+
+        // Pull later entries of the same probe run back into the hole
+        auto hole = static_cast<std::size_t>(bucket - buckets.data());
+        for (auto i = (hole + 1) % kIndexSize; buckets[i] != 0; i = (i + 1) % kIndexSize) {
+            auto home = Home(keyOf(static_cast<Slot>(buckets[i] - 1)));
+            bool homeInRange = hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+            if (!homeInRange) {
+                buckets[hole] = buckets[i];
+                hole = i;
+            }
+        }
+        buckets[hole] = 0;
+    }
+
+    ParryChainTable::Chain* ParryChainTable::FindChain(std::uint64_t key) {
+        auto bucket = chainIndex.Find(key, [this](Slot slot) { return chains[slot].key; });
+        return bucket ? &chains[*bucket - 1] : nullptr;
+    }
+
+    ParryChainTable::Blocker* ParryChainTable::FindBlocker(RE::FormID formID) {
+        auto bucket = blockerIndex.Find(formID, [this](Slot slot) { return std::uint64_t{ blockers[slot].formID }; });
+        return bucket ? &blockers[*bucket - 1] : nullptr;
+    }
+
+    const ParryChainTable::Blocker* ParryChainTable::FindBlocker(RE::FormID formID) const {
+        auto bucket = blockerIndex.Find(formID, [this](Slot slot) { return std::uint64_t{ blockers[slot].formID }; });
+        return bucket ? &blockers[*bucket - 1] : nullptr;
+    }
+
+    ParryChainTable::Slot ParryChainTable::AcquireBlocker(RE::FormID formID) {
+        if (auto blocker = FindBlocker(formID)) {
+            return static_cast<Slot>(blocker - blockers.data());
+        }
+
+        // Never runs dry - every record holds at least one of the kMaxChains chains
+        auto slot = freeBlockers[--freeBlockerCount];
+        blockers[slot] = { formID, 0, 0 };
+        blockerIndex.Insert(formID, slot);
+        ++blockerCount;
+        return slot;
+    }
+
+    void ParryChainTable::HeapSwap(std::size_t a, std::size_t b) {
+        std::swap(heap[a], heap[b]);
+        chains[heap[a]].heapPos = static_cast<Slot>(a);
+        chains[heap[b]].heapPos = static_cast<Slot>(b);
+    }
+
+    void ParryChainTable::SiftUp(std::size_t pos) {
+        while (pos > 0) {
+            auto parent = (pos - 1) / 2;
+            if (chains[heap[parent]].expiresAt <= chains[heap[pos]].expiresAt) break;
+            HeapSwap(pos, parent);
+            pos = parent;
+        }
+    }
+
+    void ParryChainTable::SiftDown(std::size_t pos) {
+        while (true) {
+            auto smallest = pos;
+            for (auto child : { pos * 2 + 1, pos * 2 + 2 }) {
+                if (child < heapSize && chains[heap[child]].expiresAt < chains[heap[smallest]].expiresAt) {
+                    smallest = child;
+                }
+            }
+            if (smallest == pos) break;
+            HeapSwap(pos, smallest);
+            pos = smallest;
+        }
+    }
+
+    void ParryChainTable::HeapRemove(std::size_t pos) {
+        --heapSize;
+        if (pos == heapSize) return;
+
+        HeapSwap(pos, heapSize);
+        SiftUp(pos);
+        SiftDown(pos);
+    }
+
+    void ParryChainTable::Free(Slot slot) {
+        auto& chain = chains[slot];
+        if (chain.key == 0) return;
+
+        chainIndex.Erase(chain.key, [this](Slot other) { return chains[other].key; });
+        HeapRemove(chain.heapPos);
+
+        auto& blocker = blockers[chain.blockerSlot];
+        if (--blocker.chains == 0) {
+            blockerIndex.Erase(blocker.formID, [this](Slot other) { return std::uint64_t{ blockers[other].formID }; });
+            blocker = {};
+            freeBlockers[freeBlockerCount++] = chain.blockerSlot;
+            --blockerCount;
+        }
+
+        chain = {};
+        freeChains[freeChainCount++] = slot;
+    }
+
+    void ParryChainTable::Reclaim(Clock::time_point now) {
+        // Only chains that have expired are touched - the heap front is always the next to go
+        while (heapSize > 0 && chains[heap[0]].expiresAt <= now) {
+            Free(heap[0]);
+        }
+    }
+
+    std::uint32_t ParryChainTable::GetCount(RE::FormID blocker, RE::FormID aggressor, Clock::time_point now) {
+        Reclaim(now);
+
+        auto chain = FindChain(MakeKey(blocker, aggressor));
+        return chain ? chain->count : 0;
+    }
+
+    std::uint32_t ParryChainTable::GetLastCount(RE::FormID blocker, Clock::time_point now) {
+        Reclaim(now);
+
+        auto record = FindBlocker(blocker);
+        if (!record) return 0;
+
+        auto chain = FindChain(MakeKey(blocker, record->lastAggressor));
+        return chain ? chain->count : 0;
+    }
+
+    bool ParryChainTable::IsLastAggressor(RE::FormID blocker, RE::FormID aggressor) const {
+        auto record = FindBlocker(blocker);
+        return !record || record->lastAggressor == aggressor;
+    }
+
+    void ParryChainTable::Set(RE::FormID blocker, RE::FormID aggressor, std::uint32_t count,
+        Clock::time_point now, Clock::time_point expiresAt)
+    {
+        Reclaim(now);
+
+        auto key = MakeKey(blocker, aggressor);
+        auto chain = FindChain(key);
+
+        if (count == 0) {
+            if (chain) Free(static_cast<Slot>(chain - chains.data()));
+            if (auto record = FindBlocker(blocker)) record->lastAggressor = aggressor;
+            return;
+        }
+
+        if (chain) {
+            chain->count = count;
+            chain->expiresAt = expiresAt;
+            SiftUp(chain->heapPos);
+            SiftDown(chain->heapPos);
+        }
+        else {
+            if (freeChainCount == 0) {
+                // Every slot is live - drop the chain that would have ended first
+                Free(heap[0]);
+            }
+
+            auto slot = freeChains[--freeChainCount];
+            auto blockerSlot = AcquireBlocker(blocker);
+            ++blockers[blockerSlot].chains;
+
+            chains[slot] = { key, count, static_cast<Slot>(heapSize), blockerSlot, expiresAt };
+            chainIndex.Insert(key, slot);
+            heap[heapSize++] = slot;
+            SiftUp(heapSize - 1);
+        }
+
+        if (auto record = FindBlocker(blocker)) record->lastAggressor = aggressor;
+    }
+
+    bool ParryChainTable::End(RE::FormID blocker, RE::FormID aggressor, Clock::time_point now) {
+        Reclaim(now);
+
+        auto chain = FindChain(MakeKey(blocker, aggressor));
+        if (!chain) return false;
+
+        Free(static_cast<Slot>(chain - chains.data()));
+        return true;
+    }
+
+    bool ParryChainTable::ClearBlocker(RE::FormID blocker) {
+        auto record = FindBlocker(blocker);
+        if (!record) return false;
+
+        // Death/unload only - walks the slots until the blocker's last chain is gone
+        for (std::size_t slot = 0; slot < kMaxChains && record->formID == blocker; ++slot) {
+            if (static_cast<RE::FormID>(chains[slot].key >> 32) == blocker) {
+                Free(static_cast<Slot>(slot));
+            }
+        }
+        return true;
+    }
+
+    void ParryChainTable::Clear() {
+        chains.fill({});
+        blockers.fill({});
+        chainIndex = {};
+        blockerIndex = {};
+        heapSize = 0;
+        blockerCount = 0;
+
+        for (std::size_t i = 0; i < kMaxChains; ++i) {
+            freeChains[i] = static_cast<Slot>(kMaxChains - 1 - i);
+            freeBlockers[i] = static_cast<Slot>(kMaxChains - 1 - i);
+        }
+        freeChainCount = kMaxChains;
+        freeBlockerCount = kMaxChains;
+    }
+
+}
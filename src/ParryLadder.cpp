@@ -0,0 +1,155 @@
+#include "TheLastBreath/ParryLadder.h"
+#include "TheLastBreath/Config.h"
+#include <SimpleIni.h>
+#include <string>
+
+namespace TheLastBreath {
+
+    namespace {
+
+        constexpr const char* LADDER_SECTION = "ParryLadder";
+        constexpr const char* PLUGIN_NAME = "TheLastBreath.esp";
+
+        // The classic 5-level ladder: used when no [ParryLadder] is configured
+        // and as the source of per-level defaults for custom ladders
+        const std::vector<ParryLevel>& BuiltInLevels() {
+            static const std::vector<ParryLevel> levels = {
+                //  window  stagger  timeout  weapon  shield  spark  flare  ring
+                { 0.30f,  0.1f,   1.0f,    0x800,  0x804,  true, true, false },
+                { 0.25f,  0.2f,   1.0f,    0x801,  0x805,  true, true, false },
+                { 0.20f,  0.3f,   1.0f,    0x802,  0x806,  true, true, false },
+                { 0.15f,  0.4f,   1.0f,    0x803,  0x807,  true, true, false },
+                { 0.10f,  10.0f,  1.0f,    0x817,  0x818,  true, true, true  },
+            };
+            return levels;
+        }
+
+        // Final level of any ladder defaults to the built-in perfect parry,
+        // earlier levels to the matching built-in level (or the last regular one)
+        std::size_t BuiltInIndex(uint32_t index, uint32_t count) {
+            const auto& builtIn = BuiltInLevels();
+            return index + 1 == count ? builtIn.size() - 1 : std::min<std::size_t>(index, builtIn.size() - 2);
+        }
+
+        const ParryLevel& DefaultLevel(uint32_t index, uint32_t count) {
+            return BuiltInLevels()[BuiltInIndex(index, count)];
+        }
+
+        // Keys from before the ladder existed. They still override the built-in default
+        // of the level they used to drive, so an INI tuned for the fixed 5 levels keeps working.
+        ParryLevel LegacyDefaultLevel(const CSimpleIniA& ini, uint32_t index, uint32_t count,
+            std::vector<std::string>& usedKeys) {
+            ParryLevel level = DefaultLevel(index, count);
+
+            auto builtInIndex = BuiltInIndex(index, count);
+            bool isFinal = builtInIndex + 1 == BuiltInLevels().size();
+
+            auto read = [&](const char* section, const std::string& key, float& field) {
+                if (!ini.GetValue(section, key.c_str(), nullptr)) return;
+                field = static_cast<float>(ini.GetDoubleValue(section, key.c_str(), field));
+                if (std::ranges::find(usedKeys, key) == usedKeys.end()) {
+                    usedKeys.push_back(key);
+                }
+            };
+
+            read("TimedBlocking", "fTimedBlockWindow" + std::to_string(builtInIndex + 1), level.window);
+            read("ParrySystem", isFinal ? std::string("fPerfectParryStaggerMagnitude") :
+                "fParryStaggerMagnitude" + std::to_string(builtInIndex + 1), level.staggerMagnitude);
+            return level;
+        }
+
+        float ReadFloat(const CSimpleIniA& ini, const char* section, const char* key, float defaultValue,
+            float minValue, float maxValue) {
+            float value = static_cast<float>(ini.GetDoubleValue(section, key, defaultValue));
+            if (value < minValue || value > maxValue) {
+                logger::warn("[{}] {} = {} is out of range [{}, {}] - clamping", section, key, value, minValue, maxValue);
+                value = std::clamp(value, minValue, maxValue);
+            }
+            return value;
+        }
+
+        RE::BGSSoundDescriptorForm* LookupSound(RE::TESDataHandler* dataHandler, RE::FormID formID) {
+            if (!dataHandler || formID == 0) return nullptr;
+            return dataHandler->LookupForm<RE::BGSSoundDescriptorForm>(formID, PLUGIN_NAME);
+        }
+
+    }
+
+    ParryLadder::ParryLadder() :
+        levels(BuiltInLevels()) {
+        Rebuild();
+    }
+
+    void ParryLadder::Load() {
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        if (ini.LoadFile(Config::GetConfigPath().string().c_str()) < 0) {
+            logger::warn("Parry ladder: config file not found - using built-in ladder");
+        }
+
+        long configuredCount = ini.GetLongValue(LADDER_SECTION, "iLevelCount", static_cast<long>(BuiltInLevels().size()));
+        if (configuredCount < 1 || configuredCount > static_cast<long>(kMaxLevels)) {
+            logger::warn("[{}] iLevelCount = {} is out of range [1, {}] - clamping", LADDER_SECTION, configuredCount, kMaxLevels);
+            configuredCount = std::clamp<long>(configuredCount, 1, kMaxLevels);
+        }
+        auto count = static_cast<uint32_t>(configuredCount);
+
+        std::vector<ParryLevel> loaded;
+        loaded.reserve(count);
+
+        auto dataHandler = RE::TESDataHandler::GetSingleton();
+        std::vector<std::string> legacyKeys;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto defaults = LegacyDefaultLevel(ini, i, count, legacyKeys);
+            std::string section = std::string(LADDER_SECTION) + ".Level" + std::to_string(i + 1);
+            const char* name = section.c_str();
+
+            ParryLevel level;
+            level.window = ReadFloat(ini, name, "fWindow", defaults.window, 0.0f, 2.0f);
+            level.staggerMagnitude = ReadFloat(ini, name, "fStaggerMagnitude", defaults.staggerMagnitude, 0.0f, 20.0f);
+            level.timeoutIncrement = ReadFloat(ini, name, "fTimeoutIncrement", defaults.timeoutIncrement, 0.0f, 60.0f);
+
+            // SimpleIni accepts 0x-prefixed hex, matching how FormIDs are usually written
+            level.weaponSoundID = static_cast<RE::FormID>(ini.GetLongValue(name, "iWeaponSound", defaults.weaponSoundID));
+            level.shieldSoundID = static_cast<RE::FormID>(ini.GetLongValue(name, "iShieldSound", defaults.shieldSoundID));
+
+            level.spark = ini.GetBoolValue(name, "bSpark", defaults.spark);
+            level.flare = ini.GetBoolValue(name, "bFlare", defaults.flare);
+            level.ring = ini.GetBoolValue(name, "bRing", defaults.ring);
+
+            level.weaponSound = LookupSound(dataHandler, level.weaponSoundID);
+            level.shieldSound = LookupSound(dataHandler, level.shieldSoundID);
+            if (!level.weaponSound || !level.shieldSound) {
+                logger::error("Parry ladder level {}: failed to load sounds (weapon: {:X}, shield: {:X})",
+                    i + 1, level.weaponSoundID, level.shieldSoundID);
+            }
+
+            loaded.push_back(level);
+        }
+
+        for (const auto& key : legacyKeys) {
+            logger::warn("{} is deprecated - move it to the matching [{}.LevelN] section (fWindow / fStaggerMagnitude)",
+                key, LADDER_SECTION);
+        }
+
+        levels = std::move(loaded);
+        Rebuild();
+
+        logger::info("Parry ladder loaded: {} levels", levels.size());
+        for (uint32_t i = 0; i < levels.size(); ++i) {
+            const auto& level = levels[i];
+            logger::debug("  Level {}: window {:.3f}s, stagger {:.1f}, timeout +{:.1f}s{}",
+                i + 1, level.window, level.staggerMagnitude, level.timeoutIncrement,
+                IsFinalLevel(i + 1) ? " (PERFECT)" : "");
+        }
+    }
+
+    void ParryLadder::Rebuild() {
+        cumulativeTimeout.assign(levels.size() + 1, 0.0f);
+        for (std::size_t i = 0; i < levels.size(); ++i) {
+            cumulativeTimeout[i + 1] = cumulativeTimeout[i] + levels[i].timeoutIncrement;
+        }
+    }
+
+}
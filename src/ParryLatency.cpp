@@ -0,0 +1,95 @@
+#include "TheLastBreath/ParryLatency.h"
+#include "TheLastBreath/Metrics.h"
+
+namespace TheLastBreath {
+
+    namespace {
+
+        std::uint64_t MicrosBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
+        }
+
+    }
+
+    ParryLatency::Trace& ParryLatency::Acquire(RE::FormID formID) {
+        // NOTE: Mutex already held by caller
+        if (auto it = std::ranges::find(traces, formID, &Trace::formID); it != traces.end()) {
+            return *it;
+        }
+
+        // Free slots have no press stamp, so they go first
+        auto& trace = *std::ranges::min_element(traces, {}, [](const Trace& candidate) {
+            return candidate.stamps[static_cast<std::size_t>(ParryStage::Press)];
+        });
+        trace.formID = formID;
+        trace.stamps.fill(TimePoint{});
+        return trace;
+    }
+
+    void ParryLatency::Checkpoint(RE::Actor* actor, ParryStage stage) {
+        if (!actor) return;
+
+        auto metrics = Metrics::GetSingleton();
+        if (!metrics->IsEnabled()) return;
+
+        auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(tracesMutex);
+
+        auto& stamps = Acquire(actor->GetFormID()).stamps;
+        auto stamp = [&](ParryStage s) -> TimePoint& { return stamps[static_cast<std::size_t>(s)]; };
+        auto has = [&](ParryStage s) { return stamp(s) != TimePoint{}; };
+
+        switch (stage) {
+        case ParryStage::Press:
+            // A new press starts a new trace
+            stamps.fill(TimePoint{});
+            stamp(ParryStage::Press) = now;
+            return;
+
+        case ParryStage::WindowOpen:
+            // Only the first observation counts - later ticks see the same window
+            if (!has(ParryStage::Press) || has(ParryStage::WindowOpen)) return;
+            metrics->Record(Histogram::PressToWindowOpen, MicrosBetween(stamp(ParryStage::Press), now));
+            break;
+
+        case ParryStage::HookDecision:
+            if (!has(ParryStage::Press)) return;
+            metrics->Record(Histogram::PressToHookDecision, MicrosBetween(stamp(ParryStage::Press), now));
+            break;
+
+        case ParryStage::HitConfirmed:
+            if (has(ParryStage::HookDecision)) {
+                metrics->Record(Histogram::HookDecisionToConfirm, MicrosBetween(stamp(ParryStage::HookDecision), now));
+            }
+            break;
+
+        case ParryStage::EffectsIssued:
+            if (has(ParryStage::HitConfirmed)) {
+                metrics->Record(Histogram::ConfirmToEffects, MicrosBetween(stamp(ParryStage::HitConfirmed), now));
+            }
+            if (has(ParryStage::Press)) {
+                metrics->Record(Histogram::PressToEffects, MicrosBetween(stamp(ParryStage::Press), now));
+            }
+            // The hit is finished - the next timed block on this press starts from the window again
+            stamp(ParryStage::HookDecision) = TimePoint{};
+            stamp(ParryStage::HitConfirmed) = TimePoint{};
+            return;
+
+        default:
+            return;
+        }
+
+        stamp(stage) = now;
+    }
+
+    void ParryLatency::ClearActor(RE::Actor* actor) {
+        if (!actor) return;
+
+        std::lock_guard<std::mutex> lock(tracesMutex);
+        if (auto it = std::ranges::find(traces, actor->GetFormID(), &Trace::formID); it != traces.end()) {
+            *it = {};
+        }
+    }
+
+}
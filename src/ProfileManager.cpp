@@ -0,0 +1,311 @@
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/Config.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+#include "TheLastBreath/WeaponStatsCache.h"
+#include <SimpleIni.h>
+#include <cctype>
+#include <cstdlib>
+#include <optional>
+
+namespace TheLastBreath {
+
+    namespace {
+
+        constexpr std::string_view PROFILE_SECTION_PREFIX = "Profile.";
+
+        constexpr std::size_t SlotOf(RE::FormID formID) {
+            return static_cast<std::size_t>((formID * 0x9E3779B1u) >> 22);  // Top 10 bits
+        }
+
+        constexpr std::uint64_t Pack(RE::FormID formID, std::uint16_t generation, std::size_t index) {
+            return (static_cast<std::uint64_t>(formID) << 32) | (static_cast<std::uint64_t>(generation) << 16) |
+                static_cast<std::uint64_t>(index + 1);
+        }
+
+        constexpr std::array<std::string_view, static_cast<std::size_t>(EquipClass::kCount)> EQUIP_CLASS_NAMES = {
+            "HandToHand", "Sword", "Dagger", "WarAxe", "Mace", "Greatsword",
+            "Battleaxe", "Bow", "Staff", "Crossbow", "Shield"
+        };
+
+        bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+            return std::ranges::equal(a, b, [](char x, char y) {
+                return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            });
+        }
+
+        struct Rule {
+            std::string name;
+            std::optional<EquipClass> equipClass;   // empty = any equipment
+            std::uint32_t bucket = 0;               // 0 = any race/keyword
+            std::optional<float> timedBlockWindowMult;
+            std::optional<float> parryStaggerMult;
+            std::optional<float> blockHoldStaminaCostPerSecond;
+            std::optional<float> rangedHoldStaminaCostPerSecond;
+            std::optional<float> lightAttackStaminaCostMult;
+
+            // Broad rules apply first so specific ones win
+            int Specificity() const {
+                return (equipClass ? 1 : 0) + (bucket ? 2 : 0);
+            }
+
+            void ApplyTo(Profile& profile) const {
+                if (timedBlockWindowMult) profile.timedBlockWindowMult = *timedBlockWindowMult;
+                if (parryStaggerMult) profile.parryStaggerMult = *parryStaggerMult;
+                if (blockHoldStaminaCostPerSecond) profile.blockHoldStaminaCostPerSecond = *blockHoldStaminaCostPerSecond;
+                if (rangedHoldStaminaCostPerSecond) profile.rangedHoldStaminaCostPerSecond = *rangedHoldStaminaCostPerSecond;
+                if (lightAttackStaminaCostMult) profile.lightAttackStaminaCostMult = *lightAttackStaminaCostMult;
+            }
+        };
+
+        // Global values form the base of every profile
+        Profile MakeBaseProfile() {
+            auto config = Config::GetSingleton();
+
+            Profile base;
+            base.blockHoldStaminaCostPerSecond = config->blockHoldStaminaCostPerSecond;
+            base.rangedHoldStaminaCostPerSecond = config->rangedHoldStaminaCostPerSecond;
+            base.lightAttackStaminaCostMult = config->lightAttackStaminaCostMult;
+            return base;
+        }
+
+        std::optional<float> ReadOptionalFloat(const CSimpleIniA& ini, const char* section, const char* key) {
+            const char* value = ini.GetValue(section, key, nullptr);
+            if (!value) return std::nullopt;
+            return std::max(0.0f, static_cast<float>(std::atof(value)));
+        }
+
+    }
+
+    void ProfileManager::Compile() {
+        CSimpleIniA ini;
+        ini.SetUnicode();
+        if (ini.LoadFile(Config::GetConfigPath().string().c_str()) < 0) {
+            logger::warn("Profiles: config file not found - using global values only");
+        }
+
+        std::unordered_map<RE::FormID, std::uint32_t> races;
+        std::vector<std::pair<RE::BGSKeyword*, std::uint32_t>> keywords;
+        std::uint32_t nextBucket = 1;
+        std::vector<Rule> rules;
+
+        CSimpleIniA::TNamesDepend sections;
+        ini.GetAllSections(sections);
+        sections.sort(CSimpleIniA::Entry::LoadOrder());
+
+        for (const auto& entry : sections) {
+            std::string_view sectionName = entry.pItem;
+            if (!sectionName.starts_with(PROFILE_SECTION_PREFIX)) {
+                continue;
+            }
+
+            const char* section = entry.pItem;
+            Rule rule;
+            rule.name = sectionName.substr(PROFILE_SECTION_PREFIX.size());
+
+            if (const char* equipment = ini.GetValue(section, "sEquipment", nullptr); equipment && *equipment) {
+                auto it = std::ranges::find_if(EQUIP_CLASS_NAMES, [&](auto name) { return EqualsIgnoreCase(name, equipment); });
+                if (it == EQUIP_CLASS_NAMES.end()) {
+                    logger::warn("Profile '{}': unknown equipment class '{}' - rule skipped", rule.name, equipment);
+                    continue;
+                }
+                rule.equipClass = static_cast<EquipClass>(std::distance(EQUIP_CLASS_NAMES.begin(), it));
+            }
+
+            const char* raceID = ini.GetValue(section, "sRace", nullptr);
+            const char* keywordID = ini.GetValue(section, "sKeyword", nullptr);
+
+            if (raceID && *raceID) {
+                auto race = RE::TESForm::LookupByEditorID<RE::TESRace>(raceID);
+                if (!race) {
+                    logger::warn("Profile '{}': race '{}' not found - rule skipped", rule.name, raceID);
+                    continue;
+                }
+                auto [it, inserted] = races.try_emplace(race->GetFormID(), nextBucket);
+                if (inserted) ++nextBucket;
+                rule.bucket = it->second;
+
+                if (keywordID && *keywordID) {
+                    logger::warn("Profile '{}': both sRace and sKeyword set - using sRace", rule.name);
+                }
+            }
+            else if (keywordID && *keywordID) {
+                auto keyword = RE::TESForm::LookupByEditorID<RE::BGSKeyword>(keywordID);
+                if (!keyword) {
+                    logger::warn("Profile '{}': keyword '{}' not found - rule skipped", rule.name, keywordID);
+                    continue;
+                }
+                auto it = std::ranges::find_if(keywords, [&](const auto& pair) { return pair.first == keyword; });
+                if (it == keywords.end()) {
+                    keywords.emplace_back(keyword, nextBucket++);
+                    it = std::prev(keywords.end());
+                }
+                rule.bucket = it->second;
+            }
+
+            rule.timedBlockWindowMult = ReadOptionalFloat(ini, section, "fTimedBlockWindowMult");
+            rule.parryStaggerMult = ReadOptionalFloat(ini, section, "fParryStaggerMult");
+            rule.blockHoldStaminaCostPerSecond = ReadOptionalFloat(ini, section, "fBlockHoldStaminaCostPerSecond");
+            rule.rangedHoldStaminaCostPerSecond = ReadOptionalFloat(ini, section, "fRangedHoldStaminaCostPerSecond");
+            rule.lightAttackStaminaCostMult = ReadOptionalFloat(ini, section, "fLightAttackStaminaCost");
+
+            rules.push_back(std::move(rule));
+        }
+
+        // Stable sort keeps INI order within the same specificity
+        std::ranges::stable_sort(rules, {}, &Rule::Specificity);
+
+        // Cache entries hold the profile index in 16 bits
+        constexpr std::uint32_t kMaxBuckets = 0xFFFE / kEquipClassCount;
+        if (nextBucket > kMaxBuckets) {
+            logger::warn("Profiles: {} race/keyword buckets, only the first {} are used", nextBucket - 1, kMaxBuckets - 1);
+            nextBucket = kMaxBuckets;
+            std::erase_if(races, [&](const auto& pair) { return pair.second >= nextBucket; });
+            std::erase_if(keywords, [&](const auto& pair) { return pair.second >= nextBucket; });
+            std::erase_if(rules, [&](const Rule& rule) { return rule.bucket >= nextBucket; });
+        }
+
+        // Bake every (bucket, equipment) combination once
+        auto compiled = std::make_unique<Table>();
+        compiled->profiles.assign(nextBucket * kEquipClassCount, MakeBaseProfile());
+        for (std::uint32_t bucket = 0; bucket < nextBucket; ++bucket) {
+            for (std::size_t equip = 0; equip < kEquipClassCount; ++equip) {
+                auto& profile = compiled->profiles[bucket * kEquipClassCount + equip];
+                for (const auto& rule : rules) {
+                    bool equipMatches = !rule.equipClass || static_cast<std::size_t>(*rule.equipClass) == equip;
+                    bool bucketMatches = rule.bucket == 0 || rule.bucket == bucket;
+                    if (equipMatches && bucketMatches) {
+                        rule.ApplyTo(profile);
+                    }
+                }
+            }
+        }
+
+        compiled->bucketCount = nextBucket;
+        compiled->raceBuckets = std::move(races);
+        compiled->keywordBuckets = std::move(keywords);
+
+        auto published = Publish(std::move(compiled), true);
+
+        logger::info("Compiled {} profile rules into {} profiles ({} race/keyword buckets)",
+            rules.size(), published->profiles.size(), published->bucketCount - 1);
+    }
+
+    const ProfileManager::Table* ProfileManager::Publish(std::unique_ptr<Table> next, bool replace) {
+        std::lock_guard<std::mutex> lock(publishMutex);
+
+        // Another first lookup already published the global-values table
+        if (auto current = table.load(std::memory_order_acquire); current && !replace) {
+            return current;
+        }
+
+        next->generation = static_cast<std::uint16_t>(tables.size() + 1);
+        tables.push_back(std::move(next));
+
+        auto published = tables.back().get();
+        table.store(published, std::memory_order_release);
+        return published;
+    }
+
+    const ProfileManager::Table* ProfileManager::GetTable() {
+        if (auto current = table.load(std::memory_order_acquire)) {
+            return current;
+        }
+
+        // Not compiled yet - a single bucket of global values
+        auto base = std::make_unique<Table>();
+        base->profiles.assign(kEquipClassCount, MakeBaseProfile());
+        return Publish(std::move(base), false);
+    }
+
+    EquipClass ProfileManager::GetEquipClass(RE::Actor* actor) {
+        if (!actor) return EquipClass::HandToHand;
+
+        auto equipment = EquipmentSnapshot::GetSingleton()->Get(actor);
+        if (equipment.HasShield()) {
+            return EquipClass::Shield;
+        }
+
+        // Weapon types and equipment classes share their values up to Crossbow
+        auto stats = WeaponStatsCache::GetSingleton();
+        for (auto hand : { equipment.right, equipment.left }) {
+            if (auto item = stats->Find(hand); item && !item->IsShield()) {
+                return static_cast<EquipClass>(item->type);
+            }
+        }
+
+        return EquipClass::HandToHand;
+    }
+
+    std::uint32_t ProfileManager::GetBucket(const Table& current, RE::Actor* actor) {
+        if (current.bucketCount <= 1) return 0;
+
+        if (auto race = actor->GetRace()) {
+            if (auto it = current.raceBuckets.find(race->GetFormID()); it != current.raceBuckets.end()) {
+                return it->second;
+            }
+        }
+
+        for (const auto& [keyword, bucket] : current.keywordBuckets) {
+            if (actor->HasKeyword(keyword)) {
+                return bucket;
+            }
+        }
+
+        // Then the keywords of what the actor holds (e.g. WeapMaterialDaedric)
+        auto equipment = EquipmentSnapshot::GetSingleton()->Get(actor);
+        auto stats = WeaponStatsCache::GetSingleton();
+        for (const auto& [keyword, bucket] : current.keywordBuckets) {
+            auto keywordID = keyword->GetFormID();
+            if (stats->HasKeyword(equipment.right, keywordID) || stats->HasKeyword(equipment.left, keywordID)) {
+                return bucket;
+            }
+        }
+
+        return 0;
+    }
+
+    std::size_t ProfileManager::Resolve(const Table& current, RE::Actor* actor) {
+        auto equip = static_cast<std::size_t>(GetEquipClass(actor));
+        if (equip >= kEquipClassCount) {
+            equip = static_cast<std::size_t>(EquipClass::HandToHand);
+        }
+        return GetBucket(current, actor) * kEquipClassCount + equip;
+    }
+
+    Profile ProfileManager::GetProfile(RE::Actor* actor) {
+        const auto& current = *GetTable();
+        if (!actor) return current.profiles.front();
+
+        auto formID = actor->GetFormID();
+        auto& slot = actorProfiles[SlotOf(formID)];
+
+        auto cached = slot.load(std::memory_order_acquire);
+        if ((cached >> 32) == formID && ((cached >> 16) & 0xFFFF) == current.generation) {
+            return current.profiles[(cached & 0xFFFF) - 1];
+        }
+
+        auto index = Resolve(current, actor);
+
+        // Only cached once the hands have settled after an equip event, and if the slot
+        // wasn't invalidated or taken while resolving
+        if (EquipmentSnapshot::GetSingleton()->IsSettled(formID)) {
+            slot.compare_exchange_strong(cached, Pack(formID, current.generation, index), std::memory_order_acq_rel);
+        }
+        return current.profiles[index];
+    }
+
+    void ProfileManager::InvalidateActor(RE::FormID formID) {
+        auto& slot = actorProfiles[SlotOf(formID)];
+
+        auto cached = slot.load(std::memory_order_acquire);
+        while ((cached >> 32) == formID && !slot.compare_exchange_weak(cached, 0, std::memory_order_acq_rel)) {
+        }
+    }
+
+    void ProfileManager::ClearAll() {
+        for (auto& slot : actorProfiles) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+
+}
@@ -0,0 +1,135 @@
+#include "TheLastBreath/Profiler.h"
+
+#ifdef TLB_ENABLE_PROFILER
+
+#include "TheLastBreath/Config.h"
+#include <fstream>
+
+namespace TheLastBreath {
+
+    namespace {
+        // Spans still open when a capture stops get this long to finish before the file is written
+        constexpr auto kStopGrace = 50ms;
+    }
+
+    Profiler::ThreadBuffer* Profiler::LocalBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            std::lock_guard<std::mutex> lock(buffersMutex);
+            auto& created = buffers.emplace_back(std::make_unique<ThreadBuffer>());
+            created->threadIndex = static_cast<std::uint32_t>(buffers.size());
+            buffer = created.get();
+        }
+        return buffer;
+    }
+
+    void Profiler::Record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+        auto buffer = LocalBuffer();
+
+        auto index = buffer->count.load(std::memory_order_relaxed);
+        if (index >= kMaxEventsPerThread) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer->events[index] = { name, start, end };
+        buffer->count.store(index + 1, std::memory_order_release);
+    }
+
+    void Profiler::StartCapture() {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        if (capturing.load() || pendingWrite.load()) return;
+
+        for (auto& buffer : buffers) {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+
+        captureStart = std::chrono::steady_clock::now();
+        capturing.store(true, std::memory_order_release);
+
+        logger::info("Profiler capture started");
+    }
+
+    void Profiler::StopCapture() {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        if (!capturing.exchange(false)) return;
+
+        captureStop = std::chrono::steady_clock::now();
+        pendingWrite.store(true);
+
+        logger::info("Profiler capture stopped - writing trace");
+    }
+
+    void Profiler::ToggleCapture() {
+        if (IsCapturing()) {
+            StopCapture();
+        }
+        else {
+            StartCapture();
+        }
+    }
+
+    void Profiler::Tick() {
+        auto now = std::chrono::steady_clock::now();
+
+        if (IsCapturing()) {
+            float duration = Config::GetSingleton()->profilerCaptureDuration;
+            if (duration > 0.0f && now - captureStart >= std::chrono::duration<float>(duration)) {
+                StopCapture();
+            }
+            return;
+        }
+
+        if (pendingWrite.load() && now - captureStop >= kStopGrace) {
+            WriteTrace();
+        }
+    }
+
+    void Profiler::WriteTrace() {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        pendingWrite.store(false);
+
+        auto directory = logger::log_directory();
+        if (!directory) return;
+
+        auto path = *directory / ("TheLastBreath_Trace_" + std::to_string(++captureNumber) + ".json");
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) {
+            logger::warn("Profiler: failed to open {}", path.string());
+            return;
+        }
+
+        auto toMicros = [&](std::chrono::steady_clock::time_point time) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(time - captureStart).count();
+        };
+
+        std::size_t written = 0;
+        std::size_t dropped = 0;
+        bool first = true;
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (const auto& buffer : buffers) {
+            auto count = buffer->count.load(std::memory_order_acquire);
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+            if (count == 0) continue;
+
+            file << (first ? "" : ",") << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadIndex
+                 << ",\"args\":{\"name\":\"TheLastBreath thread " << buffer->threadIndex << "\"}}";
+            first = false;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto& event = buffer->events[i];
+                file << ",\n{\"ph\":\"X\",\"name\":\"" << event.name << "\",\"pid\":1,\"tid\":" << buffer->threadIndex
+                     << ",\"ts\":" << toMicros(event.start) << ",\"dur\":" << toMicros(event.end) - toMicros(event.start) << '}';
+            }
+            written += count;
+        }
+        file << "\n]}\n";
+
+        logger::info("Profiler trace written to {} ({} spans, {} dropped)", path.string(), written, dropped);
+    }
+
+}
+
+#endif
@@ -1,5 +1,14 @@
 #include "TheLastBreath/RangedStaminaHandler.h"
+#include "TheLastBreath/ActorValueCache.h"
 #include "TheLastBreath/Config.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/Telemetry.h"
+#include "TheLastBreath/StaminaLedger.h"
+#include "TheLastBreath/StateExport.h"
+#include "TheLastBreath/WeaponStatsCache.h"
 
 namespace TheLastBreath {
 
@@ -7,6 +16,7 @@ namespace TheLastBreath {
         const RE::MenuOpenCloseEvent* a_event,
         RE::BSTEventSource<RE::MenuOpenCloseEvent>* a_eventSource)
     {
+        TLB_PROFILE_SCOPE("RangedStaminaHandler::ProcessEvent");
         Update();
         return RE::BSEventNotifyControl::kContinue;
     }
@@ -15,7 +25,7 @@ namespace TheLastBreath {
         if (!actor) return;
 
         auto config = Config::GetSingleton();
-        if (!config->enableStaminaManagement || !config->enableRangedStaminaCost || !config->enableRangedHoldStaminaDrain) {
+        if (!config->derived.rangedHoldDrain) {
             return;
         }
 
@@ -40,25 +50,17 @@ namespace TheLastBreath {
         if (!actor) return;
 
         auto config = Config::GetSingleton();
-        if (!config->enableStaminaManagement || !config->enableRangedStaminaCost) return;
+        if (!config->derived.rangedCost) return;
 
-        bool isRanged = false;
-        if (const auto obj = actor->GetEquippedObject(false)) {
-            if (const auto weap = obj->As<RE::TESObjectWEAP>()) {
-                const auto wt = weap->GetWeaponType();
-                isRanged = (wt == RE::WEAPON_TYPE::kBow || wt == RE::WEAPON_TYPE::kCrossbow);
-            }
-        }
+        bool isRanged = EquipmentSnapshot::GetSingleton()->Get(actor).HasRanged();
         if (!isRanged) return;
 
         if (config->enableRangedReleaseStaminaCost) {
             const float releaseCost = config->rangedReleaseStaminaCost;
             if (releaseCost > 0.0f) {
-                actor->AsActorValueOwner()->RestoreActorValue(
-                    RE::ACTOR_VALUE_MODIFIER::kDamage,
-                    RE::ActorValue::kStamina,
-                    -releaseCost);
+                StaminaLedger::GetSingleton()->Post(actor, LedgerSource::BowRelease, -releaseCost);
                 logger::debug("Ranged weapon release cost: {}", releaseCost);
+                Telemetry::GetSingleton()->RecordStamina(actor, StaminaSource::BowRelease, releaseCost);
             }
         }
 
@@ -70,10 +72,25 @@ namespace TheLastBreath {
         }
     }
 
+    float RangedStaminaHandler::GetRangedHoldCostPerSecond(RE::Actor* actor) {
+        float cost = ProfileManager::GetSingleton()->GetProfile(actor).rangedHoldStaminaCostPerSecond;
+
+        // Heavier bows take more effort to hold drawn
+        float perWeight = Config::GetSingleton()->rangedHoldStaminaCostPerWeight;
+        if (perWeight > 0.0f) {
+            auto weapon = EquipmentSnapshot::GetSingleton()->Get(actor).right;
+            if (auto stats = WeaponStatsCache::GetSingleton()->Find(weapon)) {
+                cost += perWeight * stats->weight;
+            }
+        }
+        return cost;
+    }
+
     void RangedStaminaHandler::Update() {
+        TLB_PROFILE_SCOPE("RangedStaminaHandler::Update");
         auto config = Config::GetSingleton();
 
-        if (!config->enableStaminaManagement || !config->enableRangedStaminaCost || !config->enableRangedHoldStaminaDrain) {
+        if (!config->derived.rangedHoldDrain) {
             return;
         }
 
@@ -100,13 +117,7 @@ namespace TheLastBreath {
             bool isStillDrawing = false;
             actor->GetGraphVariableBool("IsAttacking", isStillDrawing);
 
-            bool hasBowEquipped = false;
-            if (const auto obj = actor->GetEquippedObject(false)) {
-                if (const auto weap = obj->As<RE::TESObjectWEAP>()) {
-                    const auto wt = weap->GetWeaponType();
-                    hasBowEquipped = (wt == RE::WEAPON_TYPE::kBow || wt == RE::WEAPON_TYPE::kCrossbow);
-                }
-            }
+            bool hasBowEquipped = EquipmentSnapshot::GetSingleton()->Get(actor).HasRanged();
 
             if (!isStillDrawing || !hasBowEquipped) {
                 logger::debug("Bow draw interrupted - clearing tracking");
@@ -114,11 +125,17 @@ namespace TheLastBreath {
                 continue;
             }
 
+            const float costPerSecond = GetRangedHoldCostPerSecond(actor);
+
+            if (auto exporter = StateExport::GetSingleton(); exporter->IsEnabled()) {
+                exporter->SetDrain(formID, SharedState::DrainSource::BowHold, costPerSecond);
+            }
+
             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
                 now - state.lastDrainTime).count();
 
             if (elapsed >= 200) {
-                const float current = actor->AsActorValueOwner()->GetActorValue(RE::ActorValue::kStamina);
+                const float current = ActorValueCache::GetSingleton()->Get(actor, CachedValue::Stamina);
                 if (current <= 0.1f) {
                     logger::debug("Stamina exhausted - forcing bow state change");
                     actor->SetGraphVariableBool("IsAttacking", false);
@@ -128,22 +145,23 @@ namespace TheLastBreath {
                 }
 
                 const float secondsElapsed = static_cast<float>(elapsed) / 1000.0f;
-                const float costThisTick = config->rangedHoldStaminaCostPerSecond * secondsElapsed;
+                const float costThisTick = costPerSecond * secondsElapsed;
                 const float actualCost = std::min(costThisTick, current);
 
-                actor->AsActorValueOwner()->RestoreActorValue(
-                    RE::ACTOR_VALUE_MODIFIER::kDamage,
-                    RE::ActorValue::kStamina,
-                    -actualCost);
+                StaminaLedger::GetSingleton()->Post(actor, LedgerSource::BowHold, -actualCost);
 
                 logger::debug("Ranged weapon hold drain: {:.2f} stamina ({} ms since last)",
                     actualCost, static_cast<int>(elapsed));
+                Metrics::GetSingleton()->Increment(Counter::RangedDrainTicks);
+                Telemetry::GetSingleton()->RecordStamina(actor, StaminaSource::BowHold, actualCost);
 
                 state.lastDrainTime = now;
             }
 
             ++it;
         }
+
+        Metrics::GetSingleton()->SetGauge(Gauge::RangedDrainActors, static_cast<std::int64_t>(actorStates.size()));
     }
 
     bool RangedStaminaHandler::IsActorTracked(RE::Actor* actor) const {
@@ -0,0 +1,135 @@
+#include "TheLastBreath/SessionRecorder.h"
+#include "TheLastBreath/Config.h"
+
+namespace TheLastBreath {
+
+    void SessionRecorder::Start() {
+        Stop();
+
+        auto config = Config::GetSingleton();
+        if (!config->recordSessions) return;
+
+        auto directory = logger::log_directory();
+        if (!directory) return;
+
+        std::lock_guard<std::mutex> lock(recordMutex);
+
+        auto path = *directory / ("TheLastBreath_Session_" + std::to_string(++sessionNumber) + ".tlbr");
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            logger::warn("SessionRecorder: failed to open {}", path.string());
+            return;
+        }
+
+        // The config the session was played with travels with it
+        std::string snapshot = config->Serialize();
+
+        SessionLog::FileHeader header;
+        header.recordSize = sizeof(SessionLog::Record);
+        header.configSize = static_cast<std::uint32_t>(snapshot.size());
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(snapshot.data(), snapshot.size());
+
+        pendingCount = 0;
+        written = 0;
+        startTime = std::chrono::steady_clock::now();
+        recording.store(true, std::memory_order_release);
+
+        logger::info("Session recording started: {}", path.string());
+    }
+
+    void SessionRecorder::Stop() {
+        std::lock_guard<std::mutex> lock(recordMutex);
+        if (!recording.exchange(false)) return;
+
+        WritePending();
+        file.close();
+
+        logger::info("Session recording stopped ({} records)", written);
+    }
+
+    void SessionRecorder::Tick() {
+        if (!IsRecording()) return;
+
+        std::lock_guard<std::mutex> lock(recordMutex);
+        WritePending();
+        file.flush();
+    }
+
+    void SessionRecorder::WritePending() {
+        if (pendingCount == 0 || !file) return;
+
+        file.write(reinterpret_cast<const char*>(pending.data()), pendingCount * sizeof(SessionLog::Record));
+        written += pendingCount;
+        pendingCount = 0;
+    }
+
+    void SessionRecorder::Append(SessionLog::Record& record) {
+        std::lock_guard<std::mutex> lock(recordMutex);
+        if (!IsRecording()) return;
+
+        record.timeMicros = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+        // Timestamp and buffer slot are taken under the same lock so the file stays in time order
+        if (pendingCount == pending.size()) {
+            WritePending();
+        }
+        pending[pendingCount++] = record;
+    }
+
+    void SessionRecorder::RecordBlockPress(RE::Actor* actor, float delay, float window) {
+        if (!actor || !IsRecording()) return;
+
+        SessionLog::Record record;
+        record.type = SessionLog::RecordType::BlockPress;
+        record.actor = actor->GetFormID();
+        record.value0 = delay;
+        record.value1 = window;
+        Append(record);
+    }
+
+    void SessionRecorder::RecordBlockRelease(RE::Actor* actor) {
+        if (!actor || !IsRecording()) return;
+
+        SessionLog::Record record;
+        record.type = SessionLog::RecordType::BlockRelease;
+        record.actor = actor->GetFormID();
+        Append(record);
+    }
+
+    void SessionRecorder::RecordAnimEvent(RE::Actor* actor, std::uint16_t eventType) {
+        if (!actor || !IsRecording()) return;
+
+        SessionLog::Record record;
+        record.type = SessionLog::RecordType::AnimEvent;
+        record.actor = actor->GetFormID();
+        record.tag = eventType;
+        Append(record);
+    }
+
+    void SessionRecorder::RecordHit(RE::Actor* victim, RE::Actor* aggressor, float damage, std::uint8_t flags, BlockType blockType, float window) {
+        if (!victim || !IsRecording()) return;
+
+        SessionLog::Record record;
+        record.type = SessionLog::RecordType::Hit;
+        record.actor = victim->GetFormID();
+        record.other = aggressor ? aggressor->GetFormID() : 0;
+        record.value0 = damage;
+        record.value1 = window;
+        record.flags = flags;
+        record.tag = static_cast<std::uint16_t>(blockType);
+        Append(record);
+    }
+
+    void SessionRecorder::RecordCombatState(RE::Actor* actor, std::uint16_t state) {
+        if (!actor || !IsRecording()) return;
+
+        SessionLog::Record record;
+        record.type = SessionLog::RecordType::CombatState;
+        record.actor = actor->GetFormID();
+        record.tag = state;
+        Append(record);
+    }
+
+}
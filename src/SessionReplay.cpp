@@ -0,0 +1,76 @@
+#include "TheLastBreath/SessionReplay.h"
+#include <algorithm>
+
+namespace TheLastBreath {
+
+    void SessionReplay::Feed(const SessionLog::Record& record) {
+        using SessionLog::RecordType;
+
+        ++result.records;
+        result.durationMicros = std::max(result.durationMicros, record.timeMicros);
+
+        switch (record.type) {
+        case RecordType::BlockPress:
+        {
+            auto& state = actors[record.actor];
+            state.phase = BlockStateMachine::Next(state.phase, BlockInput::Press);
+            state.pressMicros = record.timeMicros;
+            state.delay = record.value0;
+            state.window = record.value1;
+            ++result.presses;
+            break;
+        }
+
+        case RecordType::BlockRelease:
+            if (auto it = actors.find(record.actor); it != actors.end()) {
+                it->second.phase = BlockStateMachine::Next(it->second.phase, BlockInput::Release);
+            }
+            break;
+
+        case RecordType::Hit:
+        {
+            ++result.hits;
+
+            bool blocked = (record.flags & SessionLog::kHitBlocked) != 0;
+            auto classified = Classify(actors[record.actor], record.timeMicros, blocked, record.value1);
+
+            switch (classified) {
+            case SessionLog::RecordedBlock::Timed:   ++result.timedBlocks; break;
+            case SessionLog::RecordedBlock::Regular: ++result.regularBlocks; break;
+            default:                                 ++result.unblockedHits; break;
+            }
+
+            if (classified != static_cast<SessionLog::RecordedBlock>(record.tag)) {
+                if (result.mismatches++ == 0) {
+                    result.firstMismatchMicros = record.timeMicros;
+                }
+            }
+            break;
+        }
+
+        default:
+            // Animation and combat state records carry context for bug reports only
+            break;
+        }
+    }
+
+    SessionLog::RecordedBlock SessionReplay::Classify(ActorState& state, std::uint64_t nowMicros, bool blocked, float hitWindow) {
+        // Same calls as TimedBlockHandler::CheckBlockType followed by ConsumeTimedBlock. The live
+        // handler sizes the window when the hit lands (the parry level can change after the press),
+        // so the window recorded with the hit is used when the log has one.
+        if (!blocked || state.phase == BlockPhase::Idle) {
+            return SessionLog::RecordedBlock::None;
+        }
+
+        float window = version >= 2 ? hitWindow : state.window;
+        float sincePress = static_cast<float>(nowMicros - state.pressMicros) / 1000000.0f;
+        state.phase = BlockStateMachine::Advance(state.phase, sincePress, state.delay, window);
+
+        auto type = BlockStateMachine::Classify(state.phase);
+        if (type == BlockType::Timed) {
+            state.phase = BlockStateMachine::Next(state.phase, BlockInput::Consume);
+        }
+        return static_cast<SessionLog::RecordedBlock>(type);
+    }
+
+}
@@ -0,0 +1,94 @@
+#include "TheLastBreath/StaminaLedger.h"
+#include "TheLastBreath/ActorValueCache.h"
+
+namespace TheLastBreath {
+
+    namespace {
+        constexpr std::array<std::string_view, static_cast<std::size_t>(LedgerSource::kCount)> SOURCE_NAMES = {
+            "jump", "rapid_combo", "bow_release", "bow_hold", "block_hold", "hit_loss", "timed_block_gain"
+        };
+    }
+
+    void StaminaLedger::Post(RE::Actor* actor, LedgerSource source, float delta) {
+        if (!actor || delta == 0.0f) return;
+
+        auto formID = actor->GetFormID();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        totals[static_cast<std::size_t>(source)] += delta;
+
+        auto& batch = batches[posting];
+        auto end = batch.entries.begin() + batch.count;
+        auto it = std::ranges::find(batch.entries.begin(), end, formID, &Pending::formID);
+
+        if (it != end) {
+            it->net += delta;
+        }
+        else if (batch.count < kMaxPending) {
+            batch.entries[batch.count++] = { formID, actor->CreateRefHandle(), delta };
+        }
+        else {
+            // More actors than a batch holds in one frame - this one gets a task of its own
+            SKSE::GetTaskInterface()->AddTask([handle = actor->CreateRefHandle(), delta]() {
+                auto ref = handle.get();
+                ApplyDelta(ref ? ref->As<RE::Actor>() : nullptr, delta);
+            });
+            return;
+        }
+
+        // One task per frame drains everything posted until it runs
+        if (!taskQueued) {
+            taskQueued = true;
+            SKSE::GetTaskInterface()->AddTask(&applyTask);
+        }
+    }
+
+    void StaminaLedger::ApplyDelta(RE::Actor* actor, float net) {
+        if (!actor || net == 0.0f) return;
+
+        // Costs that were each capped at the stamina left can still add up past it
+        auto avOwner = actor->AsActorValueOwner();
+        net = std::max(net, -avOwner->GetActorValue(RE::ActorValue::kStamina));
+
+        avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kStamina, net);
+        ActorValueCache::GetSingleton()->MarkDirty(actor->GetFormID());
+    }
+
+    void StaminaLedger::Apply() {
+        Batch* applying = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            applying = &batches[posting];
+            posting ^= 1;
+            taskQueued = false;
+        }
+
+        // Only this task touches the batch it took - Post() fills the other one meanwhile
+        for (std::size_t i = 0; i < applying->count; ++i) {
+            auto& entry = applying->entries[i];
+            auto ref = entry.handle.get();
+            ApplyDelta(ref ? ref->As<RE::Actor>() : nullptr, entry.net);
+            entry = {};
+        }
+        applying->count = 0;
+    }
+
+    void StaminaLedger::LogTotals() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < totals.size(); ++i) {
+            if (totals[i] != 0.0) {
+                logger::info("Stamina ledger: {} {:+.1f}", SOURCE_NAMES[i], totals[i]);
+            }
+        }
+    }
+
+    void StaminaLedger::ClearAll() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& batch : batches) {
+            batch.entries.fill({});
+            batch.count = 0;
+        }
+        totals.fill(0.0);
+    }
+
+}
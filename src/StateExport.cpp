@@ -0,0 +1,128 @@
+#include "TheLastBreath/StateExport.h"
+#include "TheLastBreath/Config.h"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+namespace TheLastBreath {
+
+    void StateExport::Open() {
+        if (!Config::GetSingleton()->exportSharedState || IsEnabled()) return;
+
+        auto handle = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            0, static_cast<DWORD>(sizeof(SharedState::Block)), SharedState::kMappingName);
+        if (!handle) {
+            logger::warn("StateExport: CreateFileMapping failed ({})", GetLastError());
+            return;
+        }
+
+        auto view = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedState::Block));
+        if (!view) {
+            logger::warn("StateExport: MapViewOfFile failed ({})", GetLastError());
+            CloseHandle(handle);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(stagingMutex);
+
+        mapping = handle;
+        block = new (view) SharedState::Block();
+        staging = {};
+        startTime = std::chrono::steady_clock::now();
+        enabled.store(true, std::memory_order_release);
+
+        logger::info("Live state exported to shared memory ({} bytes)", sizeof(SharedState::Block));
+    }
+
+    SharedState::ActorEntry* StateExport::FindOrAdd(RE::FormID formID) {
+        auto begin = staging.actors.begin();
+        auto end = begin + staging.actorCount;
+
+        if (auto it = std::find_if(begin, end, [&](const auto& entry) { return entry.formID == formID; }); it != end) {
+            return &*it;
+        }
+
+        if (staging.actorCount == staging.actors.size()) {
+            return nullptr;
+        }
+
+        auto& entry = staging.actors[staging.actorCount++];
+        entry = {};
+        entry.formID = formID;
+        return &entry;
+    }
+
+    void StateExport::BeginPass() {
+        if (!IsEnabled()) return;
+
+        std::lock_guard<std::mutex> lock(stagingMutex);
+        for (std::uint32_t i = 0; i < staging.actorCount; ++i) {
+            auto& entry = staging.actors[i];
+            entry.blockPhase = static_cast<std::uint8_t>(BlockPhase::Idle);
+            entry.sincePress = 0.0f;
+            entry.window = 0.0f;
+            entry.exhausted = 0;
+            entry.drainPerSecond.fill(0.0f);
+        }
+    }
+
+    void StateExport::Publish() {
+        if (!IsEnabled()) return;
+
+        std::lock_guard<std::mutex> lock(stagingMutex);
+
+        // Drop actors with nothing left to show
+        auto begin = staging.actors.begin();
+        auto end = std::remove_if(begin, begin + staging.actorCount, [](const SharedState::ActorEntry& entry) {
+            return entry.blockPhase == static_cast<std::uint8_t>(BlockPhase::Idle) && entry.parryCount == 0 &&
+                entry.exhausted == 0 && std::ranges::all_of(entry.drainPerSecond, [](float rate) { return rate == 0.0f; });
+        });
+        staging.actorCount = static_cast<std::uint32_t>(end - begin);
+
+        ++staging.publishCount;
+        staging.timeMicros = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - startTime).count());
+
+        SharedState::Write(*block, staging);
+    }
+
+    void StateExport::SetBlockState(RE::FormID formID, BlockPhase phase, float sincePress, float window) {
+        if (!IsEnabled()) return;
+
+        std::lock_guard<std::mutex> lock(stagingMutex);
+        if (auto entry = FindOrAdd(formID)) {
+            entry->blockPhase = static_cast<std::uint8_t>(phase);
+            entry->sincePress = sincePress;
+            entry->window = window;
+        }
+    }
+
+    void StateExport::SetDrain(RE::FormID formID, SharedState::DrainSource source, float perSecond) {
+        if (!IsEnabled()) return;
+
+        std::lock_guard<std::mutex> lock(stagingMutex);
+        if (auto entry = FindOrAdd(formID)) {
+            entry->drainPerSecond[static_cast<std::size_t>(source)] = perSecond;
+        }
+    }
+
+    void StateExport::SetExhausted(RE::FormID formID, bool exhausted) {
+        if (!IsEnabled()) return;
+
+        std::lock_guard<std::mutex> lock(stagingMutex);
+        if (auto entry = FindOrAdd(formID)) {
+            entry->exhausted = exhausted ? 1 : 0;
+        }
+    }
+
+    void StateExport::SetParryCount(RE::FormID formID, std::uint32_t count) {
+        if (!IsEnabled()) return;
+
+        std::lock_guard<std::mutex> lock(stagingMutex);
+        if (auto entry = FindOrAdd(formID)) {
+            entry->parryCount = static_cast<std::uint8_t>(std::min<std::uint32_t>(count, 255));
+        }
+    }
+
+}
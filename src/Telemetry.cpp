@@ -0,0 +1,239 @@
+#include "TheLastBreath/Telemetry.h"
+#include "TheLastBreath/ActorValueCache.h"
+#include "TheLastBreath/Config.h"
+#include <fstream>
+#include <iomanip>
+#include <utility>
+
+namespace TheLastBreath {
+
+    namespace {
+
+        float SecondsBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+            return std::chrono::duration<float>(to - from).count();
+        }
+
+        // Column headers, in row order. Widths are fixed so the file lines up and loads as columns.
+        constexpr std::array<std::string_view, 22> COLUMNS = {
+            "encounter", "start_s", "duration_s",
+            "parry_1", "parry_2", "parry_3", "parry_4", "parry_5", "parry_6+",
+            "timed", "regular", "success_pct", "window_pct",
+            "sta_jump", "sta_light", "sta_bow_hold", "sta_bow_release", "sta_block_hold", "sta_hit",
+            "sta_total", "exhausted_s", "exhausted_pct"
+        };
+
+        constexpr int kColumnWidth = 16;
+
+    }
+
+    Telemetry::Telemetry() :
+        lastWrite(Clock::now()),
+        startTime(lastWrite) {
+        if (auto path = logger::log_directory()) {
+            encountersPath = *path / "TheLastBreath_Encounters.txt";
+        }
+    }
+
+    bool Telemetry::IsTracked(RE::Actor* actor) const {
+        // Caller holds telemetryMutex
+        return inEncounter && actor && actor->IsPlayerRef();
+    }
+
+    void Telemetry::RecordParry(RE::Actor* actor, std::uint32_t parryLevel) {
+        if (!Config::GetSingleton()->enableTelemetry || parryLevel == 0) return;
+
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        if (!IsTracked(actor)) return;
+
+        auto column = std::min<std::size_t>(parryLevel, kParryColumns) - 1;
+        ++current.parries[column];
+    }
+
+    void Telemetry::RecordTimedBlockOffset(RE::Actor* actor, float timeInWindow, float windowDuration) {
+        if (!Config::GetSingleton()->enableTelemetry) return;
+
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        if (!IsTracked(actor)) return;
+
+        ++current.timedBlocks;
+        if (windowDuration > 0.0f) {
+            current.windowOffsetSum += std::clamp(timeInWindow / windowDuration, 0.0f, 1.0f);
+        }
+    }
+
+    void Telemetry::RecordRegularBlock(RE::Actor* actor) {
+        if (!Config::GetSingleton()->enableTelemetry) return;
+
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        if (!IsTracked(actor)) return;
+
+        ++current.regularBlocks;
+    }
+
+    void Telemetry::RecordStamina(RE::Actor* actor, StaminaSource source, float amount) {
+        if (!Config::GetSingleton()->enableTelemetry || amount <= 0.0f) return;
+
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        if (!IsTracked(actor)) return;
+
+        current.stamina[static_cast<std::size_t>(source)] += amount;
+    }
+
+    void Telemetry::SetPendingAttackCost(RE::Actor* actor, float lightCost) {
+        if (!Config::GetSingleton()->enableTelemetry || !actor || !actor->IsPlayerRef()) return;
+
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        pendingAttackCost = lightCost;
+    }
+
+    void Telemetry::RecordAttackSwing(RE::Actor* actor) {
+        if (!Config::GetSingleton()->enableTelemetry || !actor || !actor->IsPlayerRef()) return;
+
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        float cost = std::exchange(pendingAttackCost, 0.0f);
+        if (IsTracked(actor) && cost > 0.0f) {
+            current.stamina[static_cast<std::size_t>(StaminaSource::LightAttack)] += cost;
+        }
+    }
+
+    void Telemetry::RecordExhaustion(RE::Actor* actor, bool exhausted) {
+        if (!Config::GetSingleton()->enableTelemetry) return;
+
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        if (!IsTracked(actor) || current.exhausted == exhausted) return;
+
+        auto now = Clock::now();
+        if (exhausted) {
+            current.exhaustedSince = now;
+        }
+        else {
+            current.exhaustedSeconds += SecondsBetween(current.exhaustedSince, now);
+        }
+        current.exhausted = exhausted;
+    }
+
+    void Telemetry::Tick() {
+        if (!Config::GetSingleton()->enableTelemetry) return;
+
+        auto player = RE::PlayerCharacter::GetSingleton();
+        bool inCombat = player && player->IsInCombat();
+        auto now = Clock::now();
+
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+
+        if (inCombat && !inEncounter) {
+            BeginEncounter(now);
+        }
+        else if (!inCombat && inEncounter) {
+            EndEncounter(now);
+        }
+
+        // Finished rows are written in batches, or once they have waited a flush interval
+        auto interval = std::chrono::duration<float>(Config::GetSingleton()->metricsFlushInterval);
+        if (rowCount == rows.size() || (rowCount > 0 && now - lastWrite >= interval)) {
+            WriteRows();
+            lastWrite = now;
+        }
+    }
+
+    void Telemetry::Flush() {
+        std::lock_guard<std::mutex> lock(telemetryMutex);
+        if (inEncounter) {
+            EndEncounter(Clock::now());
+        }
+        WriteRows();
+    }
+
+    void Telemetry::BeginEncounter(Clock::time_point now) {
+        current = Encounter{};
+        current.number = ++encounterCount;
+        current.start = now;
+        inEncounter = true;
+
+        // Already exhausted when the fight starts
+        if (auto player = RE::PlayerCharacter::GetSingleton()) {
+            float stamina = ActorValueCache::GetSingleton()->Get(player, CachedValue::Stamina);
+            auto config = Config::GetSingleton();
+            if (config->enableExhaustionDebuff && stamina < config->exhaustionStaminaThreshold) {
+                current.exhausted = true;
+                current.exhaustedSince = now;
+            }
+        }
+
+        logger::debug("Telemetry: encounter {} started", current.number);
+    }
+
+    void Telemetry::EndEncounter(Clock::time_point now) {
+        inEncounter = false;
+
+        if (current.exhausted) {
+            current.exhaustedSeconds += SecondsBetween(current.exhaustedSince, now);
+        }
+
+        if (rowCount == rows.size()) {
+            WriteRows();
+        }
+        rows[rowCount++] = { current, SecondsBetween(current.start, now) };
+
+        logger::debug("Telemetry: encounter {} ended", current.number);
+    }
+
+    void Telemetry::WriteRows() {
+        if (rowCount == 0) return;
+
+        // Rows that can't be written are dropped so memory stays bounded
+        std::size_t count = std::exchange(rowCount, 0);
+        if (encountersPath.empty()) return;
+
+        bool writeHeader = !std::filesystem::exists(encountersPath);
+
+        std::ofstream file(encountersPath, std::ios::app);
+        if (!file) {
+            logger::warn("Telemetry: failed to open {}", encountersPath.string());
+            return;
+        }
+
+        file << std::fixed << std::setprecision(2);
+
+        if (writeHeader) {
+            for (auto column : COLUMNS) {
+                file << std::setw(kColumnWidth) << column;
+            }
+            file << '\n';
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& [encounter, duration] = rows[i];
+
+            std::uint32_t blocks = encounter.timedBlocks + encounter.regularBlocks;
+            float successPct = blocks > 0 ? 100.0f * encounter.timedBlocks / blocks : 0.0f;
+            float windowPct = encounter.timedBlocks > 0 ?
+                static_cast<float>(100.0 * encounter.windowOffsetSum / encounter.timedBlocks) : 0.0f;
+            float staminaTotal = 0.0f;
+            for (float spent : encounter.stamina) {
+                staminaTotal += spent;
+            }
+
+            file << std::setw(kColumnWidth) << encounter.number
+                 << std::setw(kColumnWidth) << SecondsBetween(startTime, encounter.start)
+                 << std::setw(kColumnWidth) << duration;
+            for (auto parries : encounter.parries) {
+                file << std::setw(kColumnWidth) << parries;
+            }
+            file << std::setw(kColumnWidth) << encounter.timedBlocks
+                 << std::setw(kColumnWidth) << encounter.regularBlocks
+                 << std::setw(kColumnWidth) << successPct
+                 << std::setw(kColumnWidth) << windowPct;
+            for (float spent : encounter.stamina) {
+                file << std::setw(kColumnWidth) << spent;
+            }
+            file << std::setw(kColumnWidth) << staminaTotal
+                 << std::setw(kColumnWidth) << encounter.exhaustedSeconds
+                 << std::setw(kColumnWidth) << (duration > 0.0f ? 100.0f * encounter.exhaustedSeconds / duration : 0.0f)
+                 << '\n';
+        }
+
+        logger::debug("Telemetry: wrote {} encounter(s) to {}", count, encountersPath.string());
+    }
+
+}
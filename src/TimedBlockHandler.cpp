@@ -1,9 +1,36 @@
 #include "TheLastBreath/TimedBlockHandler.h"
+#include "TheLastBreath/ActorValueCache.h"
 #include "TheLastBreath/BlockEffectsHandler.h"  // ADDED - Need to get parry count
 #include "TheLastBreath/Config.h"
+#include "TheLastBreath/ParryLadder.h"
+#include "TheLastBreath/ProfileManager.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/ParryLatency.h"
+#include "TheLastBreath/Profiler.h"
+#include "TheLastBreath/SessionRecorder.h"
+#include "TheLastBreath/StateExport.h"
+#include "TheLastBreath/Telemetry.h"
 
 namespace TheLastBreath {
 
+    namespace {
+        float SecondsSince(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point now) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count() / 1000.0f;
+        }
+    }
+
+    uint32_t TimedBlockHandler::GetNextParryLevel(RE::Actor* actor) {
+        // Get current parry level from BlockEffectsHandler
+        return BlockEffectsHandler::GetSingleton()->GetCurrentParryCount(actor) + 1;  // Next parry will be 1..ladder length
+    }
+
+    float TimedBlockHandler::GetWindowDuration(RE::Actor* actor, uint32_t nextParryLevel) {
+        float window = ParryLadder::GetSingleton()->GetLevel(nextParryLevel).window;
+
+        // Per weapon/shield/race profile scaling
+        return window * ProfileManager::GetSingleton()->GetProfile(actor).timedBlockWindowMult;
+    }
+
     void TimedBlockHandler::OnButtonPressed(RE::Actor* actor) {
         if (!actor) return;
 
@@ -12,7 +39,7 @@ namespace TheLastBreath {
 
         // Check skill requirement
         if (config->enableTimedBlockSkillRequirement) {
-            float blockSkill = actor->AsActorValueOwner()->GetActorValue(RE::ActorValue::kBlock);
+            float blockSkill = ActorValueCache::GetSingleton()->Get(actor, CachedValue::Block);
             if (blockSkill < config->timedBlockRequiredSkillLevel) {
                 logger::debug("Block skill ({:.1f}) below required level ({:.1f}) - timed blocking disabled",
                     blockSkill, config->timedBlockRequiredSkillLevel);
@@ -28,11 +55,13 @@ namespace TheLastBreath {
         auto [it, inserted] = actorStates.try_emplace(formID);
         auto& state = it->second;
 
-        state.isButtonPressed = true;
-        state.windowActive = false;  // Not active yet - waiting for animation delay
-        state.windowConsumed = false;
+        state.phase = BlockStateMachine::Next(state.phase, BlockInput::Press);
         state.buttonPressTime = std::chrono::steady_clock::now();
-        state.windowStartTime = state.buttonPressTime;  // Will be updated after delay
+
+        if (auto recorder = SessionRecorder::GetSingleton(); recorder->IsRecording()) {
+            recorder->RecordBlockPress(actor, config->timedBlockAnimationDelay,
+                GetWindowDuration(actor, GetNextParryLevel(actor)));
+        }
 
         logger::debug("Block button pressed - animation delay: {:.3f}s", config->timedBlockAnimationDelay);
     }
@@ -42,16 +71,22 @@ namespace TheLastBreath {
 
         std::lock_guard<std::mutex> lock(statesMutex);
 
+        // Release always returns to Idle. The entry is kept so the next press
+        // reuses it instead of allocating a new map node.
         auto formID = actor->GetFormID();
         if (auto it = actorStates.find(formID); it != actorStates.end()) {
-            actorStates.erase(it);
+            it->second.phase = BlockStateMachine::Next(it->second.phase, BlockInput::Release);
             logger::debug("Block button released - state cleared");
         }
+
+        SessionRecorder::GetSingleton()->RecordBlockRelease(actor);
     }
 
     bool TimedBlockHandler::IsTimedBlockWindowActive(RE::Actor* actor) const {
         if (!actor) return false;
 
+        auto config = Config::GetSingleton();
+
         std::lock_guard<std::mutex> lock(statesMutex);
 
         auto it = actorStates.find(actor->GetFormID());
@@ -61,54 +96,73 @@ namespace TheLastBreath {
 
         const auto& state = it->second;
 
-        // Window must be active and not yet consumed
-        return state.windowActive && !state.windowConsumed;
+        // Window must be open and not yet consumed or expired
+        auto phase = BlockStateMachine::Advance(state.phase,
+            SecondsSince(state.buttonPressTime, std::chrono::steady_clock::now()),
+            config->timedBlockAnimationDelay,
+            GetWindowDuration(actor, GetNextParryLevel(actor)));
+
+        return phase == BlockPhase::Window;
     }
 
     void TimedBlockHandler::Update() {
+        TLB_PROFILE_SCOPE("TimedBlockHandler::Update");
         auto config = Config::GetSingleton();
         if (!config->enableTimedBlocking) return;
 
         std::lock_guard<std::mutex> lock(statesMutex);
 
         auto now = std::chrono::steady_clock::now();
+        auto exporter = StateExport::GetSingleton();
+        std::int64_t blockingActors = 0;
+
+        for (auto it = actorStates.begin(); it != actorStates.end();) {
+            auto& [formID, state] = *it;
+
+            // Idle entries are kept for the next press, but not for actors that are gone or unloaded
+            RE::Actor* actor = RE::TESForm::LookupByID<RE::Actor>(formID);
+            if (!actor || actor->IsDisabled() || actor->IsDeleted() ||
+                (state.phase == BlockPhase::Idle && !actor->Is3DLoaded())) {
+                it = actorStates.erase(it);
+                continue;
+            }
+            ++it;
 
-        for (auto& [formID, state] : actorStates) {
-            // Check if animation delay has passed and window should activate
-            if (state.isButtonPressed && !state.windowActive && !state.windowConsumed) {
-                auto timeSincePress = std::chrono::duration_cast<std::chrono::milliseconds>(
-                    now - state.buttonPressTime).count() / 1000.0f;
-
-                if (timeSincePress >= config->timedBlockAnimationDelay) {
-                    state.windowActive = true;
-                    state.windowStartTime = now;
-
-                    // Get actor and determine which window will be used
-                    RE::Actor* actor = RE::TESForm::LookupByID<RE::Actor>(formID);
-                    if (actor && !actor->IsDisabled() && !actor->IsDeleted()) {
-                        auto blockEffects = BlockEffectsHandler::GetSingleton();
-                        uint32_t currentParryCount = blockEffects->GetCurrentParryCount(actor);
-                        uint32_t nextParryLevel = currentParryCount + 1;
-
-                        float windowDuration = 0.0f;
-                        switch (nextParryLevel) {
-                        case 1: windowDuration = config->timedBlockWindow1; break;
-                        case 2: windowDuration = config->timedBlockWindow2; break;
-                        case 3: windowDuration = config->timedBlockWindow3; break;
-                        case 4: windowDuration = config->timedBlockWindow4; break;
-                        case 5: windowDuration = config->timedBlockWindow5; break;
-                        default: windowDuration = config->timedBlockWindow3; break;
-                        }
-
-                        logger::debug("Timed block window NOW active - Parry {} window: {:.3f}s",
-                            nextParryLevel, windowDuration);
-                    }
+            if (state.phase != BlockPhase::Idle) {
+                ++blockingActors;
+            }
+
+            // Only Delay and Window have time driven transitions
+            if (state.phase != BlockPhase::Delay && state.phase != BlockPhase::Window) {
+                if (state.phase != BlockPhase::Idle) {
+                    exporter->SetBlockState(formID, state.phase, SecondsSince(state.buttonPressTime, now), 0.0f);
                 }
+                continue;
             }
+
+            uint32_t nextParryLevel = GetNextParryLevel(actor);
+            float windowDuration = GetWindowDuration(actor, nextParryLevel);
+            auto previous = state.phase;
+            state.phase = BlockStateMachine::Advance(state.phase, SecondsSince(state.buttonPressTime, now),
+                config->timedBlockAnimationDelay, windowDuration);
+
+            if (previous == BlockPhase::Delay && state.phase == BlockPhase::Window) {
+                logger::debug("Timed block window NOW active - Parry {} window: {:.3f}s",
+                    nextParryLevel, windowDuration);
+                ParryLatency::GetSingleton()->Checkpoint(actor, ParryStage::WindowOpen);
+            }
+            else if (previous != BlockPhase::Held && state.phase == BlockPhase::Held) {
+                logger::debug("Timed block window expired - holding regular block");
+            }
+
+            exporter->SetBlockState(formID, state.phase, SecondsSince(state.buttonPressTime, now), windowDuration);
         }
+
+        Metrics::GetSingleton()->SetGauge(Gauge::TimedBlockActors, blockingActors);
     }
 
-    BlockType TimedBlockHandler::CheckBlockType(RE::Actor* actor) {
+    BlockType TimedBlockHandler::CheckBlockType(RE::Actor* actor, float* windowUsed) {
+        if (windowUsed) *windowUsed = 0.0f;
         if (!actor) return BlockType::None;
 
         auto config = Config::GetSingleton();
@@ -119,74 +173,65 @@ namespace TheLastBreath {
         auto formID = actor->GetFormID();
         auto it = actorStates.find(formID);
 
-        if (it == actorStates.end()) {
+        if (it == actorStates.end() || it->second.phase == BlockPhase::Idle) {
             return BlockType::None;  // Not blocking
         }
 
         auto& state = it->second;
 
-        if (!state.isButtonPressed) {
-            return BlockType::None;
-        }
-
-        // Check if window was already consumed
-        if (state.windowConsumed) {
-            logger::debug("Block window already consumed - regular block");
-            return BlockType::Regular;
-        }
-
         // ============================================
-        // CHECK ANIMATION DELAY DIRECTLY
+        // PROGRESSIVE WINDOW SYSTEM
         // ============================================
-        auto now = std::chrono::steady_clock::now();
-        auto timeSincePress = std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - state.buttonPressTime).count() / 1000.0f;
+        uint32_t nextParryLevel = GetNextParryLevel(actor);
+        float windowDuration = GetWindowDuration(actor, nextParryLevel);
+        if (windowUsed) *windowUsed = windowDuration;
 
-        // Animation delay not passed yet
-        if (timeSincePress < config->timedBlockAnimationDelay) {
-            logger::debug("Block window not yet active - in animation delay ({:.3f}s / {:.3f}s)",
-                timeSincePress, config->timedBlockAnimationDelay);
-            return BlockType::Regular;
-        }
-
-        // Calculate time since delay passed (for window duration check)
+        // Catch up on time driven transitions the update tick hasn't applied yet
+        float timeSincePress = SecondsSince(state.buttonPressTime, std::chrono::steady_clock::now());
         float timeInWindow = timeSincePress - config->timedBlockAnimationDelay;
+        auto previous = state.phase;
+        state.phase = BlockStateMachine::Advance(state.phase, timeSincePress,
+            config->timedBlockAnimationDelay, windowDuration);
 
-        // ============================================
-        // PROGRESSIVE WINDOW SYSTEM
-        // ============================================
-
-        // Get current parry level from BlockEffectsHandler
-        auto blockEffects = BlockEffectsHandler::GetSingleton();
-        uint32_t currentParryCount = blockEffects->GetCurrentParryCount(actor);
-        uint32_t nextParryLevel = currentParryCount + 1;  // Next parry will be 1-5
-
-        // Select appropriate window based on next parry level
-        float windowDuration = 0.0f;
-        switch (nextParryLevel) {
-        case 1: windowDuration = config->timedBlockWindow1; break;
-        case 2: windowDuration = config->timedBlockWindow2; break;
-        case 3: windowDuration = config->timedBlockWindow3; break;
-        case 4: windowDuration = config->timedBlockWindow4; break;
-        case 5: windowDuration = config->timedBlockWindow5; break;
-        default: windowDuration = config->timedBlockWindow3; break;  // Fallback
+        if (previous == BlockPhase::Delay && state.phase == BlockPhase::Window) {
+            ParryLatency::GetSingleton()->Checkpoint(actor, ParryStage::WindowOpen);
         }
 
-        // Check if hit is within the window
-        if (timeInWindow <= windowDuration) {
+        auto telemetry = Telemetry::GetSingleton();
+
+        switch (state.phase) {
+        case BlockPhase::Delay:
+            logger::debug("Block window not yet active - in animation delay ({:.3f}s / {:.3f}s)",
+                timeSincePress, config->timedBlockAnimationDelay);
+            telemetry->RecordRegularBlock(actor);
+            break;
+
+        case BlockPhase::Window:
             logger::info("TIMED BLOCK! Parry {} window ({:.3f}s / {:.3f}s)",
                 nextParryLevel,
                 timeInWindow,
                 windowDuration);
-            return BlockType::Timed;
-        }
-        else {
+            telemetry->RecordTimedBlockOffset(actor, timeInWindow, windowDuration);
+            break;
+
+        case BlockPhase::Consumed:
+            logger::debug("Block window already consumed - regular block");
+            telemetry->RecordRegularBlock(actor);
+            break;
+
+        case BlockPhase::Held:
             logger::debug("Regular block - missed Parry {} window ({:.3f}s / {:.3f}s)",
                 nextParryLevel,
                 timeInWindow,
                 windowDuration);
-            return BlockType::Regular;
+            telemetry->RecordRegularBlock(actor);
+            break;
+
+        default:
+            break;
         }
+
+        return BlockStateMachine::Classify(state.phase);
     }
 
     void TimedBlockHandler::ConsumeTimedBlock(RE::Actor* actor) {
@@ -196,7 +241,7 @@ namespace TheLastBreath {
 
         auto formID = actor->GetFormID();
         if (auto it = actorStates.find(formID); it != actorStates.end()) {
-            it->second.windowConsumed = true;
+            it->second.phase = BlockStateMachine::Next(it->second.phase, BlockInput::Consume);
             logger::debug("Timed block window consumed - next hit will be regular block");
         }
     }
@@ -206,11 +251,15 @@ namespace TheLastBreath {
 
         std::lock_guard<std::mutex> lock(statesMutex);
 
+        // Back to Idle rather than erased - this runs on every regular block hit, and the
+        // next press reuses the entry. Update() drops it once the actor is gone.
         auto formID = actor->GetFormID();
         if (auto it = actorStates.find(formID); it != actorStates.end()) {
-            actorStates.erase(it);
+            it->second.phase = BlockPhase::Idle;
             logger::debug("Cleared timed block state for actor");
         }
+
+        ParryLatency::GetSingleton()->ClearActor(actor);
     }
 
 }
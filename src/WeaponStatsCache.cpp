@@ -0,0 +1,114 @@
+#include "TheLastBreath/WeaponStatsCache.h"
+#include "TheLastBreath/EquipmentSnapshot.h"
+
+namespace TheLastBreath {
+
+    std::optional<WeaponStats> WeaponStatsCache::Read(RE::TESForm* form, std::vector<RE::FormID>& keywordsOut) {
+        if (!form) return std::nullopt;
+
+        WeaponStats entry;
+        RE::BGSKeywordForm* keywordForm = nullptr;
+
+        if (auto weapon = form->As<RE::TESObjectWEAP>()) {
+            auto type = weapon->GetWeaponType();
+            entry.weight = weapon->weight;
+            entry.type = static_cast<std::uint8_t>(type);
+
+            if (type == RE::WEAPON_TYPE::kBow || type == RE::WEAPON_TYPE::kCrossbow) {
+                entry.flags |= kStatRanged;
+            }
+            keywordForm = weapon;
+        }
+        else if (auto armor = form->As<RE::TESObjectARMO>(); armor && armor->IsShield()) {
+            entry.weight = armor->weight;
+            entry.flags = kStatShield;
+            keywordForm = armor;
+        }
+        else {
+            return std::nullopt;
+        }
+
+        for (std::uint32_t i = 0; i < keywordForm->numKeywords; ++i) {
+            if (auto keyword = keywordForm->keywords[i]) {
+                keywordsOut.push_back(keyword->GetFormID());
+            }
+        }
+
+        return entry;
+    }
+
+    void WeaponStatsCache::Build() {
+        auto dataHandler = RE::TESDataHandler::GetSingleton();
+        if (!dataHandler || !items.empty()) return;
+
+        auto add = [this](RE::TESForm* form) {
+            auto begin = static_cast<std::uint32_t>(keywords.size());
+            if (auto stats = Read(form, keywords)) {
+                items.emplace(form->GetFormID(), Item{ *stats, begin, static_cast<std::uint32_t>(keywords.size()) - begin });
+                return true;
+            }
+            return false;
+        };
+
+        for (auto weapon : dataHandler->GetFormArray<RE::TESObjectWEAP>()) {
+            add(weapon);
+        }
+
+        std::size_t shields = 0;
+        for (auto armor : dataHandler->GetFormArray<RE::TESObjectARMO>()) {
+            if (add(armor)) ++shields;
+        }
+
+        logger::info("Weapon stats cache built ({} weapons, {} shields, {} keywords)",
+            items.size() - shields, shields, keywords.size());
+    }
+
+    void WeaponStatsCache::ClearRuntime() {
+        std::lock_guard<std::mutex> lock(runtimeMutex);
+        runtimeItems.clear();
+    }
+
+    const WeaponStatsCache::RuntimeItem& WeaponStatsCache::GetRuntime(RE::FormID formID) {
+        // NOTE: Mutex already held by caller
+        auto [it, inserted] = runtimeItems.try_emplace(formID);
+        if (inserted) {
+            it->second.stats = Read(RE::TESForm::LookupByID(formID), it->second.keywords);
+        }
+        return it->second;
+    }
+
+    std::optional<WeaponStats> WeaponStatsCache::Find(RE::FormID formID) {
+        if (auto it = items.find(formID); it != items.end()) {
+            return it->second.stats;
+        }
+        if (!IsRuntime(formID)) return std::nullopt;
+
+        std::lock_guard<std::mutex> lock(runtimeMutex);
+        return GetRuntime(formID).stats;
+    }
+
+    bool WeaponStatsCache::HasKeyword(RE::FormID formID, RE::FormID keyword) {
+        if (auto it = items.find(formID); it != items.end()) {
+            auto begin = keywords.begin() + it->second.keywordBegin;
+            auto end = begin + it->second.keywordCount;
+            return std::find(begin, end, keyword) != end;
+        }
+        if (!IsRuntime(formID)) return false;
+
+        std::lock_guard<std::mutex> lock(runtimeMutex);
+        const auto& runtime = GetRuntime(formID).keywords;
+        return std::ranges::find(runtime, keyword) != runtime.end();
+    }
+
+    std::optional<WeaponStats> WeaponStatsCache::GetBlockingItem(RE::Actor* actor) {
+        if (!actor) return std::nullopt;
+
+        auto equipment = EquipmentSnapshot::GetSingleton()->Get(actor);
+        if (auto item = Find(equipment.left); item && item->IsShield()) {
+            return item;
+        }
+
+        return Find(equipment.right);
+    }
+
+}
@@ -0,0 +1,150 @@
+// Drives simulated parries through the game-free state the hit and parry path keeps
+// (hit deduplication, block state machine, parry chains, latency traces and metrics)
+// and fails if any of it touches the heap after warm-up.
+//
+// The calls below mirror how the handlers use that state; the handlers themselves are not
+// run. Everything built on engine types - the handlers' per-actor maps, ActorValueCache,
+// EquipmentSnapshot, StaminaLedger, SKSE tasks, sound and FX placement - is outside what
+// this test guarantees.
+#include "TheLastBreath/BlockStateMachine.h"
+#include "TheLastBreath/Config.h"
+#include "TheLastBreath/HitDeduplicator.h"
+#include "TheLastBreath/Metrics.h"
+#include "TheLastBreath/ParryChainTable.h"
+#include "TheLastBreath/ParryLatency.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+
+    std::atomic<bool> counting = false;
+    std::atomic<std::size_t> allocations = 0;
+
+    void* Allocate(std::size_t size) {
+        if (counting.load(std::memory_order_relaxed)) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (void* memory = std::malloc(size ? size : 1)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+}
+
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return std::malloc(size ? size : 1); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return std::malloc(size ? size : 1); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+
+    using namespace TheLastBreath;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr RE::FormID kPlayer = 0x14;
+    constexpr std::size_t kAttackers = 12;
+    constexpr RE::FormID kWeapon = 0x00012EB7;
+    constexpr RE::FormID kArrow = 0x0003BE11;
+
+    struct Pipeline {
+        ParryChainTable chains;
+        std::vector<RE::Actor> actors;
+        Clock::time_point now = Clock::now();
+
+        Pipeline() {
+            actors.reserve(kAttackers + 1);
+            actors.emplace_back(kPlayer);
+            for (std::size_t i = 0; i < kAttackers; ++i) {
+                actors.emplace_back(static_cast<RE::FormID>(0xFF000800 + i));
+            }
+        }
+
+        // One block press taking a hit from every attacker in turn, the way the handlers
+        // call into the shared state
+        void Press(std::size_t round) {
+            auto& blocker = actors.front();
+            auto latency = ParryLatency::GetSingleton();
+            auto metrics = Metrics::GetSingleton();
+
+            latency->Checkpoint(&blocker, ParryStage::Press);
+            chains.GetLastCount(kPlayer, now);  // Window sizing on every TimedBlockHandler tick
+
+            auto phase = BlockStateMachine::Next(BlockPhase::Idle, BlockInput::Press);
+            phase = BlockStateMachine::Advance(phase, 0.06f, 0.05f, 0.3f);
+            latency->Checkpoint(&blocker, ParryStage::WindowOpen);
+
+            for (std::size_t i = 1; i < actors.size(); ++i) {
+                now += std::chrono::milliseconds(40);
+                auto aggressor = actors[i].GetFormID();
+                bool projectile = (i + round) % 3 == 0;
+
+                metrics->Increment(Counter::HitEvents);
+                auto frame = (static_cast<std::uint64_t>(round) << 32) | i;
+                if (HitDeduplicator::GetSingleton()->IsDuplicate(kPlayer, aggressor, kWeapon, projectile ? kArrow : 0, 0, frame)) {
+                    continue;
+                }
+
+                latency->Checkpoint(&blocker, ParryStage::HookDecision);
+                latency->Checkpoint(&blocker, ParryStage::HitConfirmed);
+
+                bool timed = phase == BlockPhase::Window || (i + round) % 2 == 0;
+                if (timed) {
+                    phase = BlockStateMachine::Next(phase, BlockInput::Consume);
+
+                    auto count = chains.GetCount(kPlayer, aggressor, now) + 1;
+                    if (count >= 5) count = 0;  // Perfect parry ends the chain, the next one starts a new one
+                    chains.Set(kPlayer, aggressor, count, now, now + std::chrono::seconds(3));
+
+                    metrics->Increment(Counter::TimedBlocks);
+                    metrics->RecordParryLevel(count ? count : 5);
+                    latency->Checkpoint(&blocker, ParryStage::EffectsIssued);
+                }
+                else {
+                    chains.End(kPlayer, aggressor, now);
+                }
+            }
+
+            phase = BlockStateMachine::Next(phase, BlockInput::Release);
+
+            // Some attackers die or unload between presses and come back later
+            if (round % 4 == 0) {
+                latency->ClearActor(&actors[1 + round % kAttackers]);
+                chains.ClearBlocker(kPlayer);
+            }
+            now += std::chrono::seconds(round % 7 == 0 ? 5 : 1);
+        }
+    };
+
+}
+
+int main() {
+    Metrics::GetSingleton()->SetEnabled(true);
+
+    // Keep signatures matching across frames too, so the rings see hits inside the window
+    Config::GetSingleton()->derived.hitDeduplicationWindow = std::chrono::milliseconds(100);
+
+    Pipeline pipeline;
+
+    // Warm-up: first-use statics, thread_local metrics shard
+    for (std::size_t round = 0; round < 64; ++round) {
+        pipeline.Press(round);
+    }
+
+    counting.store(true);
+    for (std::size_t round = 64; round < 64 + 10000; ++round) {
+        pipeline.Press(round);
+    }
+    counting.store(false);
+
+    auto count = allocations.load();
+    std::printf("allocations after warm-up: %zu\n", count);
+    return count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,75 @@
+// Checks the closed-form power attack cost against engine results recorded in game
+// ([Debug] bRecordAttackCosts). Every row holds the model's inputs, the effect of the
+// perk entry point on that attack, and what the engine charged.
+// Usage: TheLastBreathAttackCostTest <AttackCosts.csv>
+//
+// A fixture without rows fails - the model has nothing to be checked against.
+#include "TheLastBreath/AttackCostFormula.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+    struct Row {
+        TheLastBreath::AttackCostFormula::Inputs inputs;
+        float entryPointMult = 1.0f;
+        float engineCost = 0.0f;
+    };
+
+    bool Parse(const std::string& line, Row& row) {
+        std::istringstream stream(line);
+        char c1, c2, c3, c4, c5, c6;
+        stream >> row.inputs.weaponBase >> c1 >> row.inputs.weaponMult >> c2 >> row.inputs.powerPenalty >> c3
+            >> row.inputs.weight >> c4 >> row.inputs.staminaMult >> c5 >> row.entryPointMult >> c6 >> row.engineCost;
+        return stream && c1 == ',' && c2 == ',' && c3 == ',' && c4 == ',' && c5 == ',' && c6 == ',';
+    }
+
+}
+
+int main(int argc, char** argv) {
+    using namespace TheLastBreath;
+
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <AttackCosts.csv>\n", argv[0]);
+        return 2;
+    }
+
+    std::ifstream file(argv[1]);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::size_t rows = 0;
+    std::size_t failures = 0;
+    std::string line;
+
+    for (std::size_t number = 1; std::getline(file, line); ++number) {
+        if (line.empty() || line.front() == '#' || line.starts_with("weapon_base")) continue;
+
+        Row row;
+        if (!Parse(line, row)) {
+            std::fprintf(stderr, "line %zu: malformed row\n", number);
+            ++failures;
+            continue;
+        }
+        ++rows;
+
+        float model = AttackCostFormula::PowerAttackCost(row.inputs) * row.entryPointMult;
+        if (!AttackCostFormula::Matches(model, row.engineCost)) {
+            std::fprintf(stderr, "line %zu: model %.4f, engine %.4f\n", number, model, row.engineCost);
+            ++failures;
+        }
+    }
+
+    if (rows == 0 && failures == 0) {
+        std::fprintf(stderr, "no recorded rows in %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("rows %zu  mismatches %zu\n", rows, failures);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
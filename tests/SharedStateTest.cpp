@@ -0,0 +1,140 @@
+// Hammers SharedState::Write and TryRead over a block mapped from a file, the way the
+// plugin and an external reader share it: one writer thread publishing as fast as it can,
+// several readers copying concurrently. Every copy TryRead accepts must be a whole payload
+// from a single Write - any mix of two publishes fails the test.
+//
+// POSIX only (mmap); the Windows named mapping goes through the same Write/TryRead.
+#include "TheLastBreath/SharedState.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+    using namespace TheLastBreath;
+
+    constexpr std::uint64_t kPublishes = 500000;
+    constexpr int kReaders = 3;
+
+    // Every field is derived from the publish number, so a torn copy can't look consistent
+    void Fill(SharedState::Payload& payload, std::uint64_t publish) {
+        payload.publishCount = publish;
+        payload.timeMicros = publish * 3;
+        payload.actorCount = static_cast<std::uint32_t>(publish % (SharedState::kMaxActors + 1));
+        for (std::size_t i = 0; i < SharedState::kMaxActors; ++i) {
+            auto& actor = payload.actors[i];
+            actor.formID = static_cast<std::uint32_t>(publish + i);
+            actor.blockPhase = static_cast<std::uint8_t>(publish % 5);
+            actor.parryCount = static_cast<std::uint8_t>(publish);
+            actor.exhausted = static_cast<std::uint8_t>(publish & 1);
+            actor.sincePress = static_cast<float>(publish % 100000);
+            actor.window = static_cast<float>(i);
+            actor.drainPerSecond.fill(static_cast<float>(publish % 1000));
+        }
+    }
+
+    bool IsConsistent(const SharedState::Payload& payload) {
+        // Publish 0 is the empty block the mapping starts with
+        SharedState::Payload expected;
+        if (payload.publishCount != 0) {
+            Fill(expected, payload.publishCount);
+        }
+        return std::memcmp(&expected, &payload, sizeof(payload)) == 0;
+    }
+
+    struct ReaderResult {
+        std::uint64_t accepted = 0;
+        std::uint64_t rejected = 0;
+        std::uint64_t torn = 0;
+        std::uint64_t backwards = 0;
+    };
+
+}
+
+int main() {
+    char path[] = "/tmp/TheLastBreath_SharedStateTest_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0 || ftruncate(fd, sizeof(SharedState::Block)) != 0) {
+        std::fprintf(stderr, "cannot create %s\n", path);
+        return EXIT_FAILURE;
+    }
+    unlink(path);
+
+    // Writer and readers get separate mappings of the same file, like separate processes would
+    void* writerView = mmap(nullptr, sizeof(SharedState::Block), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void* readerView = mmap(nullptr, sizeof(SharedState::Block), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (writerView == MAP_FAILED || readerView == MAP_FAILED) {
+        std::fprintf(stderr, "mmap failed\n");
+        return EXIT_FAILURE;
+    }
+
+    auto block = new (writerView) SharedState::Block();
+    auto readBlock = static_cast<const SharedState::Block*>(readerView);
+
+    std::atomic<bool> done = false;
+    std::vector<ReaderResult> results(kReaders);
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&, r] {
+            auto& result = results[r];
+            SharedState::Payload copy;
+            std::uint64_t last = 0;
+
+            while (!done.load(std::memory_order_acquire)) {
+                if (!SharedState::TryRead(*readBlock, copy)) {
+                    ++result.rejected;
+                    continue;
+                }
+                ++result.accepted;
+                if (!IsConsistent(copy)) ++result.torn;
+                if (copy.publishCount < last) ++result.backwards;
+                last = copy.publishCount;
+            }
+        });
+    }
+
+    SharedState::Payload payload;
+    for (std::uint64_t publish = 1; publish <= kPublishes; ++publish) {
+        Fill(payload, publish);
+        SharedState::Write(*block, payload);
+    }
+    done.store(true, std::memory_order_release);
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    ReaderResult total;
+    for (const auto& result : results) {
+        total.accepted += result.accepted;
+        total.rejected += result.rejected;
+        total.torn += result.torn;
+        total.backwards += result.backwards;
+    }
+
+    // The final publish must be readable once the writer is idle
+    SharedState::Payload last;
+    bool finalRead = SharedState::TryRead(*readBlock, last) && last.publishCount == kPublishes && IsConsistent(last);
+
+    std::printf("publishes %llu  accepted %llu  rejected %llu  torn %llu  backwards %llu  final %s\n",
+        static_cast<unsigned long long>(kPublishes),
+        static_cast<unsigned long long>(total.accepted),
+        static_cast<unsigned long long>(total.rejected),
+        static_cast<unsigned long long>(total.torn),
+        static_cast<unsigned long long>(total.backwards),
+        finalRead ? "ok" : "FAILED");
+
+    munmap(writerView, sizeof(SharedState::Block));
+    munmap(readerView, sizeof(SharedState::Block));
+
+    return total.torn == 0 && total.backwards == 0 && total.accepted > 0 && finalRead ? EXIT_SUCCESS : EXIT_FAILURE;
+}
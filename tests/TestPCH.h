@@ -0,0 +1,44 @@
+#pragma once
+
+// Stand-ins for the few game and SKSE pieces the game-free sources touch, so those sources
+// build into tests without CommonLibSSE. Used as the precompiled header in place of PCH.h.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using namespace std::literals;
+
+namespace RE {
+
+    using FormID = std::uint32_t;
+
+    class Actor {
+    public:
+        explicit Actor(FormID a_formID) :
+            formID(a_formID) {}
+
+        FormID GetFormID() const { return formID; }
+
+    private:
+        FormID formID;
+    };
+
+}
+
+// Logging is compiled out - the tests check behaviour, not log output
+namespace logger {
+
+    template <class... Args> void trace(Args&&...) {}
+    template <class... Args> void debug(Args&&...) {}
+    template <class... Args> void info(Args&&...) {}
+    template <class... Args> void warn(Args&&...) {}
+    template <class... Args> void error(Args&&...) {}
+
+    inline std::optional<std::filesystem::path> log_directory() { return std::nullopt; }
+
+}
@@ -0,0 +1,64 @@
+// Offline replay of a recorded session (TheLastBreath_Session_N.tlbr).
+// Usage: TheLastBreathReplay <session.tlbr> [repeat count]
+//
+// Prints how the recorded hits classify when replayed through the block state
+// machine calls the live handler makes, and how long the replay took, so recorded sessions double as a
+// regression and performance workload.
+#include "TheLastBreath/SessionReplay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+int main(int argc, char** argv) {
+    using namespace TheLastBreath;
+
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <session.tlbr> [repeat count]\n", argv[0]);
+        return 2;
+    }
+
+    int repeat = argc > 2 ? std::max(1, std::atoi(argv[2])) : 1;
+
+    ReplayResult result;
+    std::chrono::steady_clock::duration elapsed{};
+
+    for (int pass = 0; pass < repeat; ++pass) {
+        std::ifstream stream(argv[1], std::ios::binary);
+        SessionLog::Reader reader(stream);
+        if (!reader.Open()) {
+            std::fprintf(stderr, "%s is not a session log this build can read\n", argv[1]);
+            return 1;
+        }
+
+        SessionReplay replay(reader.GetHeader().version);
+        SessionLog::Record record;
+
+        auto start = std::chrono::steady_clock::now();
+        while (reader.Next(record)) {
+            replay.Feed(record);
+        }
+        elapsed += std::chrono::steady_clock::now() - start;
+
+        result = replay.GetResult();
+    }
+
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / repeat;
+
+    std::printf("records        %llu\n", static_cast<unsigned long long>(result.records));
+    std::printf("session_s      %.1f\n", result.durationMicros / 1000000.0);
+    std::printf("presses        %llu\n", static_cast<unsigned long long>(result.presses));
+    std::printf("hits           %llu (timed %llu, regular %llu, unblocked %llu)\n",
+        static_cast<unsigned long long>(result.hits),
+        static_cast<unsigned long long>(result.timedBlocks),
+        static_cast<unsigned long long>(result.regularBlocks),
+        static_cast<unsigned long long>(result.unblockedHits));
+    std::printf("mismatches     %llu", static_cast<unsigned long long>(result.mismatches));
+    if (result.mismatches > 0) {
+        std::printf(" (first at %.3fs)", result.firstMismatchMicros / 1000000.0);
+    }
+    std::printf("\nreplay_us      %lld per pass\n", static_cast<long long>(micros));
+
+    return result.mismatches == 0 ? 0 : 3;
+}
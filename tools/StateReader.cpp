@@ -0,0 +1,98 @@
+// Reference reader for the live state block (SharedState.h).
+// Usage: TheLastBreathStateReader [--once] [block file]
+//
+// Without a file it opens the plugin's named mapping (Windows). With a file it maps
+// that file instead, which is how the layout can be exercised off Windows.
+#include "TheLastBreath/SharedState.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    using namespace TheLastBreath;
+
+    const SharedState::Block* MapBlock(const char* path) {
+#ifdef _WIN32
+        HANDLE handle = path ?
+            CreateFileMappingA(CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr), nullptr, PAGE_READONLY, 0, 0, nullptr) :
+            OpenFileMappingW(FILE_MAP_READ, FALSE, SharedState::kMappingName);
+        if (!handle) return nullptr;
+        return static_cast<const SharedState::Block*>(MapViewOfFile(handle, FILE_MAP_READ, 0, 0, sizeof(SharedState::Block)));
+#else
+        if (!path) return nullptr;
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return nullptr;
+        void* view = mmap(nullptr, sizeof(SharedState::Block), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        return view == MAP_FAILED ? nullptr : static_cast<const SharedState::Block*>(view);
+#endif
+    }
+
+    constexpr const char* PHASE_NAMES[] = { "idle", "delay", "window", "consumed", "held" };
+
+    void Print(const SharedState::Payload& payload) {
+        std::printf("publish %llu  t=%.3fs  actors %u\n",
+            static_cast<unsigned long long>(payload.publishCount), payload.timeMicros / 1000000.0, payload.actorCount);
+
+        for (std::uint32_t i = 0; i < payload.actorCount && i < SharedState::kMaxActors; ++i) {
+            const auto& actor = payload.actors[i];
+            const char* phase = actor.blockPhase < std::size(PHASE_NAMES) ? PHASE_NAMES[actor.blockPhase] : "?";
+            std::printf("  %08X  %-8s  press %.3fs  window %.3fs  parries %u  block drain %.1f/s  bow drain %.1f/s%s\n",
+                actor.formID, phase, actor.sincePress, actor.window, actor.parryCount,
+                actor.drainPerSecond[static_cast<std::size_t>(SharedState::DrainSource::BlockHold)],
+                actor.drainPerSecond[static_cast<std::size_t>(SharedState::DrainSource::BowHold)],
+                actor.exhausted ? "  EXHAUSTED" : "");
+        }
+    }
+
+}
+
+int main(int argc, char** argv) {
+    bool once = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--once") == 0) {
+            once = true;
+        }
+        else {
+            path = argv[i];
+        }
+    }
+
+    auto block = MapBlock(path);
+    if (!block) {
+        std::fprintf(stderr, "state block not found - is bExportSharedState enabled and a save loaded?\n");
+        return 1;
+    }
+
+    SharedState::Payload payload;
+    std::uint64_t lastPublish = ~0ull;
+
+    while (true) {
+        // A failed read means the writer was mid-update - just try again
+        if (SharedState::TryRead(*block, payload) && payload.publishCount != lastPublish) {
+            lastPublish = payload.publishCount;
+            Print(payload);
+            if (once) return 0;
+        }
+        else if (block->magic != SharedState::kMagic || block->version != SharedState::kVersion) {
+            std::fprintf(stderr, "state block has an unknown layout\n");
+            return 1;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(once ? 1 : 50));
+    }
+}